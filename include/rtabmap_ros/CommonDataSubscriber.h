@@ -69,6 +69,9 @@ public:
 	int rgbdCameras() const {return isSubscribedToRGBD()?(int)rgbdSubs_.size():0;}
 	int getQueueSize() const {return queueSize_;}
 	bool isApproxSync() const {return approxSync_;}
+	double getSyncSlack() const {return syncSlack_;}
+	// Time the last synchronized set waited for its other topics (low latency sync only)
+	double getSyncAddedLatency() const {return syncAddedLatency_;}
 
 protected:
 	void setupCallbacks(rclcpp::Node & node);
@@ -196,6 +199,8 @@ protected:
 
 private:
 	bool approxSync_;
+	double syncSlack_;
+	double syncAddedLatency_;
 	std::thread* warningThread_;
 	bool callbackCalled_;
 	bool subscribedToDepth_;
@@ -235,6 +240,11 @@ private:
 	rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::ConstSharedPtr scan3dSubOnly_;
 	rclcpp::Subscription<nav_msgs::msg::Odometry>::ConstSharedPtr odomSubOnly_;
 
+	// Synchronizers are instantiated from src/impl/DataSyncTypes.h, keep it
+	// in sync with the declarations below. Multi RGBD and user data
+	// synchronizers are set up only if built with RTABMAP_SYNC_MULTI_RGBD
+	// and RTABMAP_SYNC_USER_DATA options.
+
 	// RGB + Depth
 	DATA_SYNCS3(depth, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo)
 	DATA_SYNCS4(depthScan2d, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan)
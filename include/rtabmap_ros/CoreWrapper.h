@@ -31,6 +31,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <rtabmap_ros/visibility.h>
 #include <rclcpp/rclcpp.hpp>
 
+#include <atomic>
+#include <list>
+#include <condition_variable>
+#include <functional>
+
 #include <std_srvs/srv/empty.hpp>
 
 #include <tf2_ros/buffer.h>
@@ -53,6 +58,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <rtabmap/core/OdometryInfo.h>
 
 #include "rtabmap_ros/srv/get_map.hpp"
+#include "rtabmap_ros/srv/get_map_page.hpp"
 #include "rtabmap_ros/srv/list_labels.hpp"
 #include "rtabmap_ros/srv/publish_map.hpp"
 #include "rtabmap_ros/srv/set_goal.hpp"
@@ -63,8 +69,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "rtabmap_ros/msg/odom_info.hpp"
 #include "rtabmap_ros/msg/info.hpp"
+#include "rtabmap_ros/msg/latency_trace.hpp"
 
 #include "MapsManager.h"
+#include "rtabmap_ros/MsgConversion.h"
+#include "rtabmap_ros/LatencyTracer.h"
+#include "rtabmap_ros/NodeDataCache.h"
 
 #ifdef WITH_OCTOMAP_MSGS
 #include <octomap_msgs/GetOctomap.h>
@@ -101,6 +111,34 @@ private:
 	bool odomUpdate(const nav_msgs::msg::Odometry & odomMsg, rclcpp::Time stamp);
 	bool odomTFUpdate(const rclcpp::Time & stamp); // TF odom
 
+	struct TFPrefetchRequest
+	{
+		std::string targetFrame;
+		std::string sourceFrame;
+		rclcpp::Time stamp;
+		bool optional; // the frame is still processed if not available after wait_for_transform
+	};
+	struct TFPrefetchFrame
+	{
+		std::vector<TFPrefetchRequest> transforms;
+		std::function<void()> callback;
+		double deferredTime;
+		double inputTime; // for latency trace
+	};
+	// Return true if the frame can be processed now, otherwise the callback
+	// is called later when all transforms are available.
+	bool tfPrefetchReady(const std::vector<TFPrefetchRequest> & transforms, const std::function<void()> & callback);
+	bool tfPrefetchAvailable(const std::vector<TFPrefetchRequest> & transforms, std::string * missing = 0, bool requiredOnly = false) const;
+	// Transforms looked up by odomUpdate()/odomTFUpdate(), the convert*Msg() functions
+	// and process() for a frame, at the same stamps. "sensors" are the camera frames with their stamps.
+	std::vector<TFPrefetchRequest> tfPrefetchRequests(
+			const nav_msgs::msg::Odometry::ConstSharedPtr & odomMsg,
+			const rclcpp::Time & poseStamp,
+			const std::vector<std::pair<std::string, rclcpp::Time> > & sensors,
+			const sensor_msgs::msg::LaserScan::ConstSharedPtr& scan2dMsg,
+			const sensor_msgs::msg::PointCloud2::ConstSharedPtr& scan3dMsg) const;
+	void tfPrefetchCallback();
+
 	virtual void commonDepthCallback(
 				const nav_msgs::msg::Odometry::ConstSharedPtr & odomMsg,
 				const rtabmap_ros::msg::UserData::ConstSharedPtr & userDataMsg,
@@ -184,6 +222,7 @@ private:
 	void setLogWarn(const std::shared_ptr<rmw_request_id_t>, const std::shared_ptr<std_srvs::srv::Empty::Request>, std::shared_ptr<std_srvs::srv::Empty::Response>);
 	void setLogError(const std::shared_ptr<rmw_request_id_t>, const std::shared_ptr<std_srvs::srv::Empty::Request>, std::shared_ptr<std_srvs::srv::Empty::Response>);
 	void getMapDataCallback(const std::shared_ptr<rmw_request_id_t>, const std::shared_ptr<rtabmap_ros::srv::GetMap::Request>, std::shared_ptr<rtabmap_ros::srv::GetMap::Response>);
+	void getMapDataPageCallback(const std::shared_ptr<rmw_request_id_t>, const std::shared_ptr<rtabmap_ros::srv::GetMapPage::Request>, std::shared_ptr<rtabmap_ros::srv::GetMapPage::Response>);
 	void getMapCallback(const std::shared_ptr<rmw_request_id_t>, const std::shared_ptr<nav_msgs::srv::GetMap::Request>, std::shared_ptr<nav_msgs::srv::GetMap::Response>);
 	void getProbMapCallback(const std::shared_ptr<rmw_request_id_t>, const std::shared_ptr<nav_msgs::srv::GetMap::Request>, std::shared_ptr<nav_msgs::srv::GetMap::Response>);
 	void getProjMapCallback(const std::shared_ptr<rmw_request_id_t>, const std::shared_ptr<nav_msgs::srv::GetMap::Request>, std::shared_ptr<nav_msgs::srv::GetMap::Response>);
@@ -213,7 +252,28 @@ private:
 	void publishLocalPath(const rclcpp::Time & stamp);
 	void publishGlobalPath(const rclcpp::Time & stamp);
 
+	void mapsUpdateThread();
+
 private:
+	// Snapshot of what is required to update and publish the maps
+	// outside of the SLAM thread (see "map_update_async" parameter)
+	struct MapsUpdateRequest
+	{
+		rclcpp::Time stamp;
+		std::string mapFrameId;
+		std::map<int, rtabmap::Transform> poses;
+		std::map<int, rtabmap::Signature> signatures;
+		int id; // latest node of the request
+	};
+
+	// Nodes selected by the first request of a paginated map download
+	// (see get_map_data_page service), the continuation token is
+	// "session:offset" in ids. Nodes are loaded from memory page by page.
+	struct MapDataPageSession
+	{
+		std::vector<int> ids;
+	};
+
 	rtabmap::Rtabmap rtabmap_;
 	bool paused_;
 	rtabmap::Transform lastPose_;
@@ -244,13 +304,59 @@ private:
 	double genScanMaxDepth_;
 	double genScanMinDepth_;
 	int scanCloudMaxPoints_;
+	ImageBufferPool imagePool_; // stitched rgb/depth images
 
 	rtabmap::Transform mapToOdom_;
 	std::mutex mapToOdomMutex_;
 
 	MapsManager mapsManager_;
-
+	std::mutex mapsMutex_; // mapsManager_
+	std::mutex memoryMutex_; // rtabmap_ memory, when accessed from mapsUpdateThread_
+
+	bool mapsUpdateAsync_;
+	// snapshot of mapsManager_ grid parameter read by the SLAM thread
+	// while maps are updated in mapsUpdateThread_
+	std::atomic<bool> mapsGridFromDepth_;
+	int mapsUpdateQueueSize_;
+	std::thread * mapsUpdateThread_;
+	bool mapsUpdateThreadRunning_;
+	std::list<MapsUpdateRequest> mapsUpdateQueue_;
+	std::mutex mapsUpdateQueueMutex_;
+	std::condition_variable mapsUpdateQueueCondition_;
+	int mapsUpdateDropped_;
+	double mapsUpdateLastTimeUpdate_;
+	double mapsUpdateLastTimePublish_;
+	int mapsUpdateLastId_;
+
+	bool tfPrefetch_;
+	int tfPrefetchMaxFrames_;
+	bool tfPrefetchProcessing_;
+	std::list<TFPrefetchFrame> tfPrefetchFrames_;
+	rclcpp::TimerBase::SharedPtr tfPrefetchTimer_;
+
+	bool latencyTrace_;
+	std::string latencyTraceFile_;
+	LatencyTracer latencyTracer_;
+	rclcpp::Publisher<rtabmap_ros::msg::LatencyTrace>::SharedPtr latencyTracePub_;
+	double latencyInputTime_; // synchronized input received (s)
+	double latencyTFTime_;    // odometry TF received (s)
+
+	// shared by get_map_data, publish_map and mapData topic
+	NodeDataCache nodeDataCache_;
+
+	MapGraphDeltaEncoder mapDataDeltaEncoder_;
+	MapGraphDeltaEncoder mapGraphDeltaEncoder_;
+	size_t mapDataSubscriptions_;
+	size_t mapGraphSubscriptions_;
+
+	int mapDataPageSize_;
+	int mapDataPageSessionId_;
+	std::map<int, MapDataPageSession> mapDataPageSessions_;
+
+	int infoGroups_; // see rtabmap_ros::InfoGroup
 	rclcpp::Publisher<rtabmap_ros::msg::Info>::SharedPtr infoPub_;
+	rclcpp::Publisher<rtabmap_ros::msg::Info>::SharedPtr infoTimingsPub_;
+	rclcpp::Publisher<rtabmap_ros::msg::Info>::SharedPtr infoLoopClosurePub_;
 	rclcpp::Publisher<rtabmap_ros::msg::MapData>::SharedPtr mapDataPub_;
 	rclcpp::Publisher<rtabmap_ros::msg::MapGraph>::SharedPtr mapGraphPub_;
 	rclcpp::Publisher<geometry_msgs::msg::PoseArray>::SharedPtr landmarksPub_;
@@ -292,6 +398,7 @@ private:
 	rclcpp::Service<std_srvs::srv::Empty>::SharedPtr setLogWarnSrv_;
 	rclcpp::Service<std_srvs::srv::Empty>::SharedPtr setLogErrorSrv_;
 	rclcpp::Service<rtabmap_ros::srv::GetMap>::SharedPtr getMapDataSrv_;
+	rclcpp::Service<rtabmap_ros::srv::GetMapPage>::SharedPtr getMapDataPageSrv_;
 	rclcpp::Service<nav_msgs::srv::GetMap>::SharedPtr getMapSrv_;
 	rclcpp::Service<nav_msgs::srv::GetMap>::SharedPtr getProbMapSrv_;
 	rclcpp::Service<rtabmap_ros::srv::PublishMap>::SharedPtr publishMapDataSrv_;
@@ -0,0 +1,173 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INCLUDE_RTABMAP_ROS_DATASYNC_H_
+#define INCLUDE_RTABMAP_ROS_DATASYNC_H_
+
+#include <message_filters/simple_filter.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace rtabmap_ros {
+
+namespace detail {
+// std::placeholders::_N cannot be generated from an index, use our own.
+template<int N>
+struct SyncPlaceholder {};
+}
+
+}
+
+namespace std {
+template<int N>
+struct is_placeholder<rtabmap_ros::detail::SyncPlaceholder<N> > : std::integral_constant<int, N> {};
+}
+
+namespace rtabmap_ros {
+
+template<typename... Ms>
+using DataSyncCallback = std::function<void(const typename Ms::ConstSharedPtr...)>;
+
+// The synchronizer calls its callback with 9 arguments, only the first ones are used.
+template<typename C, std::size_t... I>
+auto bindDataSyncCallback(const C & callback, std::index_sequence<I...>)
+{
+	return std::bind(callback, detail::SyncPlaceholder<I+1>()...);
+}
+
+/**
+ * Create the type-erased synchronizer of a combination of topics for one
+ * policy. The create() functions are only declared here: they are defined
+ * in src/impl/DataSync<Policy>.h and explicitly instantiated for the
+ * combinations listed in src/impl/DataSyncTypes.h, in one generated
+ * translation unit per policy and topic family (see CMakeLists.txt).
+ */
+template<typename... Ms>
+struct ExactDataSync
+{
+	static std::shared_ptr<void> create(
+			uint32_t queueSize,
+			const DataSyncCallback<Ms...> & callback,
+			message_filters::SimpleFilter<Ms> &... subs);
+};
+template<typename... Ms>
+struct ApproximateDataSync
+{
+	static std::shared_ptr<void> create(
+			uint32_t queueSize,
+			const DataSyncCallback<Ms...> & callback,
+			message_filters::SimpleFilter<Ms> &... subs);
+};
+template<typename... Ms>
+struct LowLatencyDataSync
+{
+	static std::shared_ptr<void> create(
+			uint32_t queueSize,
+			double slack,
+			double * addedLatency,
+			const DataSyncCallback<Ms...> & callback,
+			message_filters::SimpleFilter<Ms> &... subs);
+};
+
+/**
+ * Holds the synchronizer of a combination of topics for any of the
+ * supported policies (exact, approximate or low latency). Only the
+ * synchronizer of the policy selected at init() is created.
+ */
+template<typename... Ms>
+class DataSync
+{
+public:
+	DataSync() :
+		policyName_("exact")
+	{}
+
+	template<typename T, typename... Subs>
+	void init(
+			bool approx,
+			double slack,
+			double * addedLatency,
+			uint32_t queueSize,
+			void (T::*callback)(const typename Ms::ConstSharedPtr...),
+			T * obj,
+			Subs &... subs)
+	{
+		static_assert(sizeof...(Subs) == sizeof...(Ms), "One subscriber is required per message type");
+		clear();
+		DataSyncCallback<Ms...> cb = makeCallback(callback, obj, std::index_sequence_for<Ms...>());
+		if(approx && slack > 0.0)
+		{
+			sync_ = LowLatencyDataSync<Ms...>::create(queueSize, slack, addedLatency, cb, subs...);
+			policyName_ = "low latency";
+		}
+		else if(approx)
+		{
+			sync_ = ApproximateDataSync<Ms...>::create(queueSize, cb, subs...);
+			policyName_ = "approx";
+		}
+		else
+		{
+			sync_ = ExactDataSync<Ms...>::create(queueSize, cb, subs...);
+			policyName_ = "exact";
+		}
+		topics_.clear();
+		for(const std::string & topic : {std::string(subs.getTopic())...})
+		{
+			topics_ += (topics_.empty()?"\n   ":",\n   ") + topic;
+		}
+	}
+
+	void clear()
+	{
+		sync_.reset();
+	}
+
+	const char * policyName() const {return policyName_;}
+	// Subscribed topics, one per line
+	const std::string & topics() const {return topics_;}
+
+private:
+	template<typename T, std::size_t... I>
+	static auto makeCallback(
+			void (T::*callback)(const typename Ms::ConstSharedPtr...),
+			T * obj,
+			std::index_sequence<I...>)
+	{
+		return std::bind(callback, obj, detail::SyncPlaceholder<I+1>()...);
+	}
+
+private:
+	std::shared_ptr<void> sync_;
+	const char * policyName_;
+	std::string topics_;
+};
+
+}
+
+#endif /* INCLUDE_RTABMAP_ROS_DATASYNC_H_ */
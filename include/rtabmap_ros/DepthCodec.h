@@ -0,0 +1,66 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DEPTHCODEC_H_
+#define DEPTHCODEC_H_
+
+#include <opencv2/core/core.hpp>
+#include <string>
+#include <vector>
+
+namespace rtabmap_ros {
+
+/**
+ * Lossless compression of 16 bits depth images with the RVL codec (Wilson,
+ * "Fast Lossless Depth Image Compression", 2017): run lengths of invalid
+ * pixels and deltas between consecutive valid pixels are written with a
+ * variable-length nibble coding. Output can optionally be deflated with
+ * zlib for a better ratio at the cost of some encoding time.
+ */
+
+// RGBDImage::depth_compressed formats
+static const std::string kDepthFormatRVL = "rvl";
+static const std::string kDepthFormatRVLZlib = "rvl_zlib";
+
+// Returns true if the format is one of the RVL formats above
+bool isDepthFormatRVL(const std::string & format);
+
+// depth should be CV_16UC1, returns an empty buffer otherwise
+std::vector<unsigned char> compressDepthRVL(const cv::Mat & depth, bool zlib = false);
+
+// Returns a CV_16UC1 image, or an empty image if the data is corrupted. If
+// buffer is set and has the right size and type, it is decoded in place.
+cv::Mat uncompressDepthRVL(const std::vector<unsigned char> & bytes, bool zlib = false, cv::Mat * buffer = 0);
+
+// Compress depth for RGBDImage::depth_compressed with the requested format
+// ("png", "rvl" or "rvl_zlib"). Float depth images cannot be compressed
+// losslessly with RVL, they fall back to png. The format actually used is
+// returned in outputFormat.
+std::vector<unsigned char> compressDepth(const cv::Mat & depth, const std::string & format, std::string & outputFormat);
+
+}
+
+#endif /* DEPTHCODEC_H_ */
@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <nav_msgs/msg/path.hpp>
 #include <std_msgs/msg/bool.hpp>
 #include "rtabmap_ros/srv/get_map.hpp"
+#include "rtabmap_ros/MsgConversion.h"
 
 #include <rtabmap_ros/CommonDataSubscriber.h>
 
@@ -133,6 +134,7 @@ private:
 			rtabmap_ros::msg::Info,
 			rtabmap_ros::msg::MapData> MyInfoMapSyncPolicy;
 	message_filters::Synchronizer<MyInfoMapSyncPolicy> * infoMapSync_;
+	MapGraphDeltaDecoder mapGraphDecoder_;
 
 	typedef message_filters::sync_policies::ExactTime<
 			rtabmap_ros::msg::Goal,
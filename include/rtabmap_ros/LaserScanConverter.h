@@ -0,0 +1,73 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LASERSCANCONVERTER_H_
+#define LASERSCANCONVERTER_H_
+
+#include <sensor_msgs/msg/laser_scan.hpp>
+#include <opencv2/core/core.hpp>
+#include <vector>
+
+namespace rtabmap_ros {
+
+/**
+ * Project a sensor_msgs::LaserScan directly in the rtabmap 2D scan format
+ * (XY or XYNormal, in the scan frame). Sin/cos of the beams are cached
+ * until the scan geometry changes and the output buffer is reused when
+ * the previous scan returned is not referenced anymore.
+ */
+class LaserScanConverter
+{
+public:
+	LaserScanConverter();
+
+	// Beams outside [max(rangeMin, msg.range_min), min(rangeMax, msg.range_max)] are
+	// removed. Normals are computed if normalK > 0 or normalRadius > 0, points
+	// with less than 2 neighbors (no valid normal) are then removed.
+	cv::Mat convert(
+			const sensor_msgs::msg::LaserScan & msg,
+			int downsamplingStep = 1,
+			float rangeMin = 0.0f,
+			float rangeMax = 0.0f,
+			int normalK = 0,
+			float normalRadius = 0.0f);
+
+private:
+	void updateTables(const sensor_msgs::msg::LaserScan & msg);
+	// Returns the number of points kept at the beginning of scan
+	int computeNormals(cv::Mat & scan, int normalK, float normalRadius) const;
+
+private:
+	float angleMin_;
+	float angleIncrement_;
+	std::vector<float> cos_;
+	std::vector<float> sin_;
+	cv::Mat buffer_;
+};
+
+} /* namespace rtabmap_ros */
+
+#endif /* LASERSCANCONVERTER_H_ */
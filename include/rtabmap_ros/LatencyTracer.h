@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef LATENCYTRACER_H_
+#define LATENCYTRACER_H_
+
+#include <rtabmap_ros/msg/latency_trace.hpp>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace rtabmap_ros {
+
+/**
+ * Fixed size ring buffer of per-frame stage timings. Recording is
+ * lock-free and can be done from any thread, the oldest events are
+ * overwritten. The buffer can be exported as CSV or Chrome trace
+ * (chrome://tracing, Perfetto).
+ */
+class LatencyTracer
+{
+public:
+	struct Event
+	{
+		const char * stage; // should be a string literal
+		double stamp;       // sensor stamp of the frame (s)
+		double start;       // (s)
+		double duration;    // (s)
+	};
+
+public:
+	LatencyTracer(unsigned int capacity = 1000);
+
+	// Not thread-safe, do it at initialization.
+	void setCapacity(unsigned int capacity);
+	unsigned int capacity() const {return (unsigned int)slots_.size();}
+
+	// If msg is set, the stage is also added to it.
+	void record(
+			const char * stage,
+			double stamp,
+			double start,
+			double duration,
+			rtabmap_ros::msg::LatencyTrace * msg = 0);
+
+	// Events still in the buffer, from the oldest to the newest.
+	std::vector<Event> snapshot() const;
+
+	bool exportCSV(const std::string & path) const;
+	bool exportChromeTrace(const std::string & path, const std::string & processName) const;
+	// Chrome trace if extension is ".json", CSV otherwise.
+	bool exportFile(const std::string & path, const std::string & processName) const;
+
+private:
+	struct Slot
+	{
+		Slot() : sequence(0) {}
+		Slot(const Slot &) : sequence(0) {}
+		std::atomic<unsigned long long> sequence; // odd while being written
+		Event event;
+	};
+	std::vector<Slot> slots_;
+	std::atomic<unsigned long long> head_;
+};
+
+} /* namespace rtabmap_ros */
+
+#endif /* LATENCYTRACER_H_ */
@@ -0,0 +1,252 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef INCLUDE_RTABMAP_ROS_LOWLATENCYSYNCPOLICY_H_
+#define INCLUDE_RTABMAP_ROS_LOWLATENCYSYNCPOLICY_H_
+
+#include <message_filters/synchronizer.h>
+#include <message_filters/message_traits.h>
+#include <rtabmap/utilite/ULogger.h>
+
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <tuple>
+
+namespace rtabmap_ros {
+namespace sync_policies {
+
+/**
+ * Synchronization policy emitting a set as soon as all topics have a
+ * message with a stamp within "slack" seconds of a message of the first
+ * topic (the pivot). Unlike ApproximateTime, it doesn't wait for the next
+ * message of each topic to confirm the best match. Pivot messages that
+ * cannot be matched anymore (a newer message outside the slack already
+ * received on another topic) are dropped.
+ */
+template<typename M0, typename M1,
+		typename M2 = message_filters::NullType, typename M3 = message_filters::NullType, typename M4 = message_filters::NullType,
+		typename M5 = message_filters::NullType, typename M6 = message_filters::NullType, typename M7 = message_filters::NullType,
+		typename M8 = message_filters::NullType>
+struct LowLatencyTime : public message_filters::PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8>
+{
+	typedef message_filters::Synchronizer<LowLatencyTime> Sync;
+	typedef message_filters::PolicyBase<M0, M1, M2, M3, M4, M5, M6, M7, M8> Super;
+	typedef typename Super::Messages Messages;
+	typedef typename Super::Signal Signal;
+	typedef typename Super::Events Events;
+	typedef typename Super::RealTypeCount RealTypeCount;
+	typedef std::tuple<
+			std::deque<typename Super::M0Event>, std::deque<typename Super::M1Event>, std::deque<typename Super::M2Event>,
+			std::deque<typename Super::M3Event>, std::deque<typename Super::M4Event>, std::deque<typename Super::M5Event>,
+			std::deque<typename Super::M6Event>, std::deque<typename Super::M7Event>, std::deque<typename Super::M8Event> > Queues;
+
+	// If addedLatency is set, the time the pivot message waited before
+	// being emitted is written to it just before each callback.
+	LowLatencyTime(uint32_t queueSize, double slack, double * addedLatency = 0) :
+		parent_(0),
+		queueSize_(queueSize>0?queueSize:1),
+		slack_(slack),
+		addedLatency_(addedLatency),
+		lastAddedLatency_(0.0)
+	{
+	}
+
+	LowLatencyTime(const LowLatencyTime & e)
+	{
+		*this = e;
+	}
+
+	LowLatencyTime & operator=(const LowLatencyTime & rhs)
+	{
+		parent_ = rhs.parent_;
+		queueSize_ = rhs.queueSize_;
+		slack_ = rhs.slack_;
+		addedLatency_ = rhs.addedLatency_;
+		lastAddedLatency_ = rhs.lastAddedLatency_;
+		queues_ = rhs.queues_;
+		arrivals_ = rhs.arrivals_;
+		return *this;
+	}
+
+	void initParent(Sync * parent)
+	{
+		parent_ = parent;
+	}
+
+	double lastAddedLatency() const {return lastAddedLatency_;}
+
+	template<int i>
+	void add(const typename std::tuple_element<i, Events>::type & evt)
+	{
+		UASSERT(parent_ != 0);
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto & queue = std::get<i>(queues_);
+		queue.push_back(evt);
+		if(i == 0)
+		{
+			arrivals_.push_back(std::chrono::steady_clock::now());
+		}
+		if(queue.size() > queueSize_)
+		{
+			queue.pop_front();
+			if(i == 0)
+			{
+				arrivals_.pop_front();
+			}
+		}
+		process();
+	}
+
+private:
+	template<int i>
+	double stamp(const typename std::tuple_element<i, Events>::type & evt) const
+	{
+		return message_filters::message_traits::TimeStamp<typename std::tuple_element<i, Messages>::type>::value(*evt.getMessage()).seconds();
+	}
+
+	// 1: matched at index, 0: wait for more messages, -1: pivot cannot be matched
+	template<int i>
+	int select(double pivot, int & index) const
+	{
+		index = -1;
+		if constexpr (i >= RealTypeCount::value)
+		{
+			return 1;
+		}
+		else
+		{
+			const auto & queue = std::get<i>(queues_);
+			double best = slack_;
+			bool newer = false;
+			for(size_t k=0; k<queue.size(); ++k)
+			{
+				double diff = stamp<i>(queue[k]) - pivot;
+				if(std::fabs(diff) <= best)
+				{
+					best = std::fabs(diff);
+					index = (int)k;
+				}
+				else if(diff > slack_)
+				{
+					newer = true;
+				}
+			}
+			return index>=0?1:newer?-1:0;
+		}
+	}
+
+	template<int i>
+	typename std::tuple_element<i, Events>::type take(int index)
+	{
+		if constexpr (i >= RealTypeCount::value)
+		{
+			return typename std::tuple_element<i, Events>::type();
+		}
+		else
+		{
+			auto & queue = std::get<i>(queues_);
+			typename std::tuple_element<i, Events>::type evt = queue[index];
+			// older messages cannot be matched anymore
+			queue.erase(queue.begin(), queue.begin()+index+1);
+			return evt;
+		}
+	}
+
+	void process()
+	{
+		auto & pivots = std::get<0>(queues_);
+		while(!pivots.empty())
+		{
+			double pivot = stamp<0>(pivots.front());
+			int index[9] = {0};
+			int result[9] = {1};
+			result[1] = select<1>(pivot, index[1]);
+			result[2] = select<2>(pivot, index[2]);
+			result[3] = select<3>(pivot, index[3]);
+			result[4] = select<4>(pivot, index[4]);
+			result[5] = select<5>(pivot, index[5]);
+			result[6] = select<6>(pivot, index[6]);
+			result[7] = select<7>(pivot, index[7]);
+			result[8] = select<8>(pivot, index[8]);
+
+			bool wait = false;
+			bool drop = false;
+			for(int i=1; i<9; ++i)
+			{
+				drop = drop || result[i] < 0;
+				wait = wait || result[i] == 0;
+			}
+			if(drop)
+			{
+				UDEBUG("Dropping pivot message %f, no match within %fs", pivot, slack_);
+				pivots.pop_front();
+				arrivals_.pop_front();
+				continue;
+			}
+			if(wait)
+			{
+				return;
+			}
+
+			lastAddedLatency_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - arrivals_.front()).count();
+			if(addedLatency_)
+			{
+				*addedLatency_ = lastAddedLatency_;
+			}
+			UDEBUG("Synchronized %f, added latency=%fs", pivot, lastAddedLatency_);
+
+			typename Super::M0Event e0 = pivots.front();
+			pivots.pop_front();
+			arrivals_.pop_front();
+			typename Super::M1Event e1 = take<1>(index[1]);
+			typename Super::M2Event e2 = take<2>(index[2]);
+			typename Super::M3Event e3 = take<3>(index[3]);
+			typename Super::M4Event e4 = take<4>(index[4]);
+			typename Super::M5Event e5 = take<5>(index[5]);
+			typename Super::M6Event e6 = take<6>(index[6]);
+			typename Super::M7Event e7 = take<7>(index[7]);
+			typename Super::M8Event e8 = take<8>(index[8]);
+			parent_->signal(e0, e1, e2, e3, e4, e5, e6, e7, e8);
+		}
+	}
+
+private:
+	Sync * parent_;
+	uint32_t queueSize_;
+	double slack_;
+	double * addedLatency_;
+	double lastAddedLatency_;
+	Queues queues_;
+	std::deque<std::chrono::steady_clock::time_point> arrivals_;
+	std::mutex mutex_;
+};
+
+} /* namespace sync_policies */
+} /* namespace rtabmap_ros */
+
+#endif /* INCLUDE_RTABMAP_ROS_LOWLATENCYSYNCPOLICY_H_ */
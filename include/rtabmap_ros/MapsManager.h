@@ -30,12 +30,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <rtabmap/core/Signature.h>
 #include <rtabmap/core/Parameters.h>
-#include <rtabmap/core/FlannIndex.h>
+#include "rtabmap_ros/PointCloudVoxelHash.h"
+#include "rtabmap_ros/PointCloudVoxelGrid.h"
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 #include <rclcpp/rclcpp.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <nav_msgs/msg/occupancy_grid.hpp>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
 
 namespace rtabmap {
 class OctoMap;
@@ -63,7 +68,8 @@ public:
 			const rtabmap::Memory * memory,
 			bool updateGrid,
 			bool updateOctomap,
-			const std::map<int, rtabmap::Signature> & signatures = std::map<int, rtabmap::Signature>());
+			const std::map<int, rtabmap::Signature> & signatures = std::map<int, rtabmap::Signature>(),
+			std::mutex * memoryMutex = 0); // if set, locked when accessing memory
 
 	void publishMaps(
 			const std::map<int, rtabmap::Transform> & poses,
@@ -84,6 +90,17 @@ public:
 	const rtabmap::OccupancyGrid * getOccupancyGrid() const {return occupancyGrid_;}
 
 private:
+	void loadGridMapsParallel(
+			const std::map<int, rtabmap::Transform> & poses,
+			const rtabmap::Memory * memory,
+			const std::map<int, rtabmap::Signature> & signatures,
+			std::mutex * memoryMutex,
+			bool occupancySavedInDB);
+	// Run job(workerIndex) on all grid workers and wait until they are all done
+	void runGridWorkers(const std::function<void(int)> & job);
+	void gridWorkerLoop(int index);
+	void stopGridWorkers();
+
 	// mapping stuff
 	bool cloudOutputVoxelized_;
 	bool cloudSubtractFiltering_;
@@ -93,6 +110,7 @@ private:
 	bool mapCacheCleanup_;
 	bool alwaysUpdateMap_;
 	bool scanEmptyRayTracing_;
+	int mapUpdateThreads_;
 
 	rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr cloudMapPub_;
 	rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr cloudGroundPub_;
@@ -116,8 +134,18 @@ private:
 	std::map<int, rtabmap::Transform> assembledObstaclePoses_;
 	pcl::PointCloud<pcl::PointXYZRGB>::Ptr assembledObstacles_;
 	pcl::PointCloud<pcl::PointXYZRGB>::Ptr assembledGround_;
-	rtabmap::FlannIndex assembledGroundIndex_;
-	rtabmap::FlannIndex assembledObstacleIndex_;
+	pcl::PointCloud<pcl::PointXYZRGB>::Ptr assembledObstaclesBuffer_; // contiguous per node blocks (not voxelized)
+	pcl::PointCloud<pcl::PointXYZRGB>::Ptr assembledGroundBuffer_; // contiguous per node blocks (not voxelized)
+	std::map<int, std::pair<int, int> > assembledObstacleBlocks_; // <id, <offset, size> > in assembledObstaclesBuffer_
+	std::map<int, std::pair<int, int> > assembledGroundBlocks_; // <id, <offset, size> > in assembledGroundBuffer_
+	pcl::PointCloud<pcl::PointXYZRGB> assembledObstaclesTmp_; // points of temporary nodes (id<=0), removed at next update
+	pcl::PointCloud<pcl::PointXYZRGB> assembledGroundTmp_; // points of temporary nodes (id<=0), removed at next update
+	rtabmap_ros::PointCloudVoxelGrid assembledGroundVoxels_; // cloud_output_voxelized
+	rtabmap_ros::PointCloudVoxelGrid assembledObstacleVoxels_; // cloud_output_voxelized
+	rtabmap_ros::PointCloudVoxelHash assembledGroundIndex_;
+	rtabmap_ros::PointCloudVoxelHash assembledObstacleIndex_;
+	bool assembledGroundIndexDirty_;
+	bool assembledObstacleIndexDirty_;
 	std::map<int, pcl::PointCloud<pcl::PointXYZRGB>::Ptr > groundClouds_;
 	std::map<int, pcl::PointCloud<pcl::PointXYZRGB>::Ptr > obstacleClouds_;
 
@@ -129,6 +157,19 @@ private:
 	rtabmap::OccupancyGrid * occupancyGrid_;
 	bool gridUpdated_;
 
+	// Persistent workers of loadGridMapsParallel(). Each one has its own
+	// OccupancyGrid (same parameters than occupancyGrid_), as createLocalMap()
+	// is not reentrant.
+	std::vector<std::thread*> gridWorkers_;
+	std::vector<rtabmap::OccupancyGrid*> gridWorkerGrids_;
+	std::function<void(int)> gridWorkersJob_;
+	unsigned int gridWorkersJobId_;
+	int gridWorkersPending_;
+	bool gridWorkersStop_;
+	std::mutex gridWorkersMutex_;
+	std::condition_variable gridWorkersCondition_;
+	std::condition_variable gridWorkersDoneCondition_;
+
 	rtabmap::OctoMap * octomap_;
 	int octomapTreeDepth_;
 	bool octomapUpdated_;
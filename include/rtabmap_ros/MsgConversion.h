@@ -36,11 +36,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sensor_msgs/msg/camera_info.hpp>
 #include <sensor_msgs/msg/laser_scan.hpp>
 #include <sensor_msgs/msg/image.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
 
 #include <opencv2/opencv.hpp>
 #include <opencv2/features2d/features2d.hpp>
 #include <cv_bridge/cv_bridge.h>
 
+#include <tuple>
+
 #include <rtabmap/core/Transform.h>
 #include <rtabmap/core/Link.h>
 #include <rtabmap/core/Signature.h>
@@ -60,8 +63,75 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <rtabmap_ros/msg/rgbd_image.hpp>
 #include <rtabmap_ros/msg/user_data.hpp>
 
+#include <list>
+#include <mutex>
+
 namespace rtabmap_ros {
 
+class NodeDataCache;
+
+// Reusable image buffers. A buffer is given back only when nobody else
+// references it anymore (e.g., a SensorData created from a previous frame).
+class ImageBufferPool
+{
+public:
+	ImageBufferPool(unsigned int maxSize = 4) : maxSize_(maxSize) {}
+	cv::Mat acquire(int rows, int cols, int type);
+	void clear();
+
+private:
+	unsigned int maxSize_;
+	std::list<cv::Mat> buffers_;
+	std::mutex mutex_;
+};
+
+// Fill a PointCloud2 directly, without intermediate pcl cloud. Fields
+// are x,y,z, optionally rgb (packed like pcl::PointXYZRGB) and
+// optionally normal_x,normal_y,normal_z.
+class PointCloud2Writer
+{
+public:
+	PointCloud2Writer(sensor_msgs::msg::PointCloud2 & msg, size_t size, bool rgb = false, bool normals = false);
+
+	size_t size() const {return msg_.width;}
+
+	void set(size_t i, float x, float y, float z)
+	{
+		float * ptr = (float*)(msg_.data.data() + i*msg_.point_step);
+		ptr[0] = x;
+		ptr[1] = y;
+		ptr[2] = z;
+	}
+	void set(size_t i, float x, float y, float z, unsigned char r, unsigned char g, unsigned char b)
+	{
+		set(i, x, y, z);
+		uint32_t rgb = ((uint32_t)r << 16 | (uint32_t)g << 8 | (uint32_t)b);
+		memcpy(msg_.data.data() + i*msg_.point_step + 12, &rgb, sizeof(uint32_t));
+	}
+	void setNormal(size_t i, float nx, float ny, float nz)
+	{
+		float * ptr = (float*)(msg_.data.data() + i*msg_.point_step + normalsOffset_);
+		ptr[0] = nx;
+		ptr[1] = ny;
+		ptr[2] = nz;
+	}
+
+private:
+	sensor_msgs::msg::PointCloud2 & msg_;
+	unsigned int normalsOffset_;
+};
+
+// Points are transformed if transform is set
+void points3fToROS(
+		const std::vector<cv::Point3f> & points,
+		sensor_msgs::msg::PointCloud2 & msg,
+		const rtabmap::Transform & transform = rtabmap::Transform());
+// x,y,z and normals (if the scan has them), transformed if transform is set
+void laserScanToROS(
+		const rtabmap::LaserScan & scan,
+		sensor_msgs::msg::PointCloud2 & msg,
+		const rtabmap::Transform & transform = rtabmap::Transform());
+
 void transformToTF(const rtabmap::Transform & transform, tf2::Transform & tfTransform);
 rtabmap::Transform transformFromTF(const tf2::Transform & transform);
 
@@ -73,6 +143,11 @@ rtabmap::Transform transformFromPoseMsg(const geometry_msgs::msg::Pose & msg);
 
 void toCvCopy(const rtabmap_ros::msg::RGBDImage & image, cv_bridge::CvImagePtr & rgb, cv_bridge::CvImagePtr & depth);
 void toCvShare(const rtabmap_ros::msg::RGBDImage::ConstSharedPtr & image, cv_bridge::CvImageConstPtr & rgb, cv_bridge::CvImageConstPtr & depth);
+// Compressed images of all messages are decoded in parallel
+void toCvShare(
+		const std::vector<rtabmap_ros::msg::RGBDImage::ConstSharedPtr> & images,
+		std::vector<cv_bridge::CvImageConstPtr> & rgb,
+		std::vector<cv_bridge::CvImageConstPtr> & depth);
 rtabmap::SensorData rgbdImageFromROS(const rtabmap_ros::msg::RGBDImage::ConstSharedPtr & image);
 
 // copy data
@@ -80,7 +155,18 @@ void compressedMatToBytes(const cv::Mat & compressed, std::vector<unsigned char>
 cv::Mat compressedMatFromBytes(const std::vector<unsigned char> & bytes, bool copy = true);
 
 void infoFromROS(const rtabmap_ros::msg::Info & info, rtabmap::Statistics & stat);
-void infoToROS(const rtabmap::Statistics & stats, rtabmap_ros::msg::Info & info);
+// Statistics groups copied in Info messages by infoToROS(). Ids and the
+// loop closure transform are always set.
+enum InfoGroup
+{
+	kInfoNone = 0,
+	kInfoTimings = 1,     // "Timing/" statistics
+	kInfoLoopClosure = 2, // "Loop/" statistics, posterior, likelihood and raw likelihood
+	kInfoFull = 0xFF      // all the above plus weights, labels, local path and other statistics
+};
+void infoToROS(const rtabmap::Statistics & stats, rtabmap_ros::msg::Info & info, int groups = kInfoFull);
+// Same as above for several messages (message, groups) in one pass over the statistics
+void infoToROS(const rtabmap::Statistics & stats, const std::vector<std::pair<rtabmap_ros::msg::Info*, int> > & infos);
 
 rtabmap::Link linkFromROS(const rtabmap_ros::msg::Link & msg);
 void linkToROS(const rtabmap::Link & link, rtabmap_ros::msg::Link & msg);
@@ -133,7 +219,8 @@ void mapDataToROS(
 		const std::multimap<int, rtabmap::Link> & links,
 		const std::map<int, rtabmap::Signature> & signatures,
 		const rtabmap::Transform & mapToOdom,
-		rtabmap_ros::msg::MapData & msg);
+		rtabmap_ros::msg::MapData & msg,
+		NodeDataCache * cache = 0); // if set, nodes are converted through the cache
 
 void mapGraphFromROS(
 		const rtabmap_ros::msg::MapGraph & msg,
@@ -146,6 +233,57 @@ void mapGraphToROS(
 		const rtabmap::Transform & mapToOdom,
 		rtabmap_ros::msg::MapGraph & msg);
 
+// Delta encoding of MapGraph messages (also used for MapData::graph): only
+// poses and links added, changed or removed since the previous message are
+// sent, with a full graph every keyframeInterval messages (0 = always full).
+class MapGraphDeltaEncoder
+{
+public:
+	MapGraphDeltaEncoder(int keyframeInterval = 0);
+
+	void setKeyframeInterval(int keyframeInterval) {keyframeInterval_ = keyframeInterval;}
+	int keyframeInterval() const {return keyframeInterval_;}
+
+	// The next message will be a full graph
+	void reset();
+
+	void encode(
+			const std::map<int, rtabmap::Transform> & poses,
+			const std::multimap<int, rtabmap::Link> & links,
+			const rtabmap::Transform & mapToOdom,
+			rtabmap_ros::msg::MapGraph & msg);
+
+private:
+	int keyframeInterval_;
+	unsigned int sequence_;
+	int sinceKeyframe_;
+	std::map<int, rtabmap::Transform> poses_;
+	std::map<std::tuple<int, int, int>, rtabmap::Link> links_; // key is (from, to, type)
+};
+
+// Reconstruct the full graph from a stream of MapGraph messages, either
+// delta-encoded or not.
+class MapGraphDeltaDecoder
+{
+public:
+	MapGraphDeltaDecoder();
+
+	// Returns false if the graph cannot be reconstructed because a message of
+	// the delta stream was missed. It will be valid again at the next full graph.
+	bool decode(
+			const rtabmap_ros::msg::MapGraph & msg,
+			std::map<int, rtabmap::Transform> & poses,
+			std::multimap<int, rtabmap::Link> & links,
+			rtabmap::Transform & mapToOdom);
+	void reset();
+
+private:
+	bool valid_;
+	unsigned int sequence_;
+	std::map<int, rtabmap::Transform> poses_;
+	std::map<std::tuple<int, int, int>, rtabmap::Link> links_; // key is (from, to, type)
+};
+
 rtabmap::Signature nodeDataFromROS(const rtabmap_ros::msg::NodeData & msg);
 void nodeDataToROS(const rtabmap::Signature & signature, rtabmap_ros::msg::NodeData & msg);
 
@@ -190,6 +328,13 @@ rtabmap::Transform getTransform(
 		tf2_ros::Buffer & tfBuffer,
 		double waitForTransform);
 
+// Convert image (color conversion if needed) directly into dst, which should
+// be already allocated (e.g., a ROI of a bigger image) with the type of "encoding" (mono8 or bgr8).
+void cvtColorTo(
+		const cv_bridge::CvImageConstPtr & image,
+		const std::string & encoding,
+		cv::Mat & dst);
+
 bool convertRGBDMsgs(
 		const std::vector<cv_bridge::CvImageConstPtr> & imageMsgs,
 		const std::vector<cv_bridge::CvImageConstPtr> & depthMsgs,
@@ -201,7 +346,8 @@ bool convertRGBDMsgs(
 		cv::Mat & depth,
 		std::vector<rtabmap::CameraModel> & cameraModels,
 		tf2_ros::Buffer & tfBuffer,
-		double waitForTransform);
+		double waitForTransform,
+		ImageBufferPool * pool = 0); // if set, rgb and depth are taken from the pool
 
 bool convertStereoMsg(
 		const cv_bridge::CvImageConstPtr& leftImageMsg,
@@ -227,6 +373,20 @@ bool convertScanMsg(
 		double waitForTransform,
 		bool outputInFrameId = false);
 
+// Pack the cloud directly in scan (XYZ, XYZI or XYZRGB, with normals if
+// available), dropping NaN points and points outside [rangeMin, rangeMax]
+// (if set) and keeping one point on downsamplingStep. Returns false if
+// the x/y/z fields are not FLOAT32.
+bool laserScanFromPointCloud2(
+		const sensor_msgs::msg::PointCloud2 & msg,
+		rtabmap::LaserScan & scan,
+		const rtabmap::Transform & localTransform = rtabmap::Transform::getIdentity(),
+		int maxPoints = 0,
+		float maxRange = 0.0f,
+		float rangeMin = 0.0f,
+		float rangeMax = 0.0f,
+		int downsamplingStep = 1);
+
 bool convertScan3dMsg(
 		const sensor_msgs::msg::PointCloud2 & scan3dMsg,
 		const std::string & frameId,
@@ -243,6 +403,13 @@ void transformPointCloud (
 		const Eigen::Matrix4f &transform,
 		const sensor_msgs::msg::PointCloud2 &in,
         sensor_msgs::msg::PointCloud2 &out);
+
+// Transform in place points [begin, end) of the cloud
+void transformPointCloudPoints (
+		const Eigen::Matrix4f &transform,
+		sensor_msgs::msg::PointCloud2 &cloud,
+		size_t begin,
+		size_t end);
 }
 
 #endif /* MSGCONVERSION_H_ */
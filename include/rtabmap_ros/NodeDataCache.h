@@ -0,0 +1,94 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef NODEDATACACHE_H_
+#define NODEDATACACHE_H_
+
+#include <rtabmap_ros/msg/node_data.hpp>
+#include <rtabmap/core/Signature.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace rtabmap_ros {
+
+/**
+ * LRU cache of NodeData messages already converted from signatures, to
+ * avoid serializing again the same data (descriptors, words, grids...)
+ * each time the map is requested. An entry is used only if the
+ * content of the signature's data (compared by hash) didn't change since
+ * it was cached. Node info (weight, label, pose...) is always refreshed
+ * from the signature. Thread-safe.
+ */
+class NodeDataCache
+{
+public:
+	// Capacity in nodes, 0 disables the cache.
+	NodeDataCache(unsigned int capacity = 0);
+
+	void setCapacity(unsigned int capacity);
+	unsigned int capacity() const;
+
+	void toROS(const rtabmap::Signature & signature, rtabmap_ros::msg::NodeData & msg);
+
+	void remove(int id);
+	void clear();
+
+	unsigned int size() const;
+	unsigned long long hits() const;
+	unsigned long long misses() const;
+	float hitRate() const; // [0,1]
+
+private:
+	struct Fingerprint
+	{
+		unsigned long long hash;
+		unsigned long long bytes; // hashed size
+		bool operator==(const Fingerprint & other) const {return hash == other.hash && bytes == other.bytes;}
+	};
+	static Fingerprint fingerprint(const rtabmap::Signature & signature);
+	void evict();
+
+private:
+	struct Entry
+	{
+		Fingerprint fingerprint;
+		std::shared_ptr<const rtabmap_ros::msg::NodeData> msg;
+		std::list<int>::iterator lruIter;
+	};
+
+	mutable std::mutex mutex_;
+	unsigned int capacity_;
+	std::map<int, Entry> entries_;
+	std::list<int> lru_; // most recently used first
+	unsigned long long hits_;
+	unsigned long long misses_;
+};
+
+} /* namespace rtabmap_ros */
+
+#endif /* NODEDATACACHE_H_ */
@@ -42,10 +42,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <rtabmap_ros/msg/odom_info.hpp>
 #include <rtabmap_ros/srv/reset_pose.hpp>
+#include <rtabmap_ros/msg/latency_trace.hpp>
+#include <rtabmap_ros/LatencyTracer.h>
 #include <rtabmap/core/SensorData.h>
 #include <rtabmap/core/Parameters.h>
+#include <rtabmap/core/Features2d.h>
 
 #include <boost/thread.hpp>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace rtabmap {
 class Odometry;
@@ -80,7 +87,9 @@ public:
 protected:
 	void init(bool stereoParams, bool visParams, bool icpParams);
 	void startWarningThread(const std::string & subscribedTopicsMsg, bool approxSync);
-	void callbackCalled() {callbackCalled_ = true;}
+	void callbackCalled();
+	// getTransform() on the TF buffer of this node, the lookup time is traced
+	rtabmap::Transform lookupTransform(const std::string & fromFrameId, const std::string & toFrameId, const rclcpp::Time & stamp);
 
 	virtual void flushCallbacks() {}
 	tf2_ros::Buffer & tfBuffer() {return *tfBuffer_;}
@@ -94,6 +103,20 @@ private:
 
 	void callbackIMU(const sensor_msgs::msg::Imu::SharedPtr msg);
 	void reset(const rtabmap::Transform & pose = rtabmap::Transform::getIdentity());
+	// Latency trace of a frame before the odometry update
+	struct InputTrace
+	{
+		InputTrace() : input(0.0), tf(0.0), converted(0.0) {}
+		double input;     // synchronized callback called, arrival time (s)
+		double tf;        // time spent looking up TF (s)
+		double converted; // processData() called (s)
+	};
+	void processDataImpl(const rtabmap::SensorData & data, const rclcpp::Time & stamp, const InputTrace & trace);
+	void extractFeatures(rtabmap::SensorData & data);
+	void pipelineThreadLoop();
+	void waitPipeline();
+	void stopPipeline();
+	bool shedLoad(const rclcpp::Time & stamp, double arrivalTime);
 
 private:
 	rtabmap::Odometry * odometry_;
@@ -120,6 +143,7 @@ private:
 	rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr odomLocalMap_;
 	rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr odomLocalScanMap_;
 	rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr odomLastFrame_;
+	rclcpp::Publisher<rtabmap_ros::msg::LatencyTrace>::SharedPtr latencyTracePub_;
 
 	rclcpp::Service<std_srvs::srv::Empty>::SharedPtr resetSrv_;
 	rclcpp::Service<rtabmap_ros::srv::ResetPose>::SharedPtr resetToPoseSrv_;
@@ -149,9 +173,49 @@ private:
 	bool waitIMUToinit_;
 	bool imuProcessed_;
 	double lastImuReceivedStamp_;
-	rtabmap::SensorData bufferedData_;
+
+	// Frames waiting for IMU, ordered by stamp
+	struct BufferedFrame
+	{
+		rtabmap::SensorData data;
+		rclcpp::Time stamp;
+		rclcpp::Time received;
+		InputTrace trace;
+	};
+	std::list<BufferedFrame> bufferedData_;
+	int bufferedDataMaxSize_;
+	double bufferedDataWaitTime_;
 	std::string configPath_;
 	rtabmap::Transform initialPose_;
+
+	bool latencyTrace_;
+	std::string latencyTraceFile_;
+	LatencyTracer latencyTracer_;
+	InputTrace latencyInput_; // frame being converted by the callback, also used by load shedding
+
+	// Features of the next frame are extracted while the current one is registered
+	bool pipelined_;
+	bool pipelineDepthAsMask_;
+	rtabmap::Feature2D * pipelineFeature2D_;
+	std::thread * pipelineThread_;
+	std::mutex pipelineMutex_;
+	std::condition_variable pipelineCondition_;
+	std::condition_variable pipelineDoneCondition_;
+	bool pipelineBusy_;
+	bool pipelineStop_;
+	rtabmap::SensorData pipelineData_;
+	rclcpp::Time pipelineStamp_;
+	InputTrace pipelineTrace_;
+
+	// Load shedding: skip frames when odometry cannot follow the input rate
+	bool loadShedding_;
+	double loadSheddingMaxLag_;
+	int loadSheddingMaxSkips_;
+	double loadSheddingProcessTime_; // running average (s)
+	double loadSheddingInputPeriod_; // running average (s)
+	double loadSheddingLastInputStamp_;
+	int loadSheddingDecimation_;
+	int loadSheddingSkipped_;
 };
 
 }
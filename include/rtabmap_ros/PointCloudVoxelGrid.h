@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef POINTCLOUDVOXELGRID_H_
+#define POINTCLOUDVOXELGRID_H_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace rtabmap_ros {
+
+/**
+ * Voxel grid filter updated incrementally. The output cloud has one point per
+ * occupied voxel: the centroid of its points with their average color (like
+ * pcl::VoxelGrid). Adding or removing points only updates the voxels they fall
+ * in. When a voxel gets empty, the last point of the output is moved in its
+ * place, so all other voxels stay where they are in the output.
+ */
+class PointCloudVoxelGrid
+{
+public:
+	PointCloudVoxelGrid(float voxelSize = 0.05f);
+
+	bool setVoxelSize(float voxelSize); // clear the grid and return true if voxel size has changed
+	float voxelSize() const {return voxelSize_;}
+	void clear();
+
+	// Add/remove the points [offset, offset+size[ of the cloud (size<0 means up to the end).
+	// Removed points should be exactly the same than those added.
+	void addPoints(const pcl::PointCloud<pcl::PointXYZRGB> & cloud, int offset = 0, int size = -1);
+	void removePoints(const pcl::PointCloud<pcl::PointXYZRGB> & cloud, int offset = 0, int size = -1);
+
+	const pcl::PointCloud<pcl::PointXYZRGB>::Ptr & cloud() const {return cloud_;}
+
+private:
+	long long key(const pcl::PointXYZRGB & pt) const;
+	void updatePoint(int index);
+
+private:
+	struct Voxel
+	{
+		Voxel() : x(0.0), y(0.0), z(0.0), r(0), g(0), b(0), count(0), index(-1) {}
+		double x, y, z; // sums
+		unsigned int r, g, b; // sums
+		int count;
+		int index; // in cloud_
+	};
+	float voxelSize_;
+	std::unordered_map<long long, Voxel> voxels_;
+	std::vector<long long> keys_; // voxel of each point of cloud_
+	pcl::PointCloud<pcl::PointXYZRGB>::Ptr cloud_;
+};
+
+} /* namespace rtabmap_ros */
+
+#endif /* POINTCLOUDVOXELGRID_H_ */
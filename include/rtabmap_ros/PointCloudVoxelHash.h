@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef POINTCLOUDVOXELHASH_H_
+#define POINTCLOUDVOXELHASH_H_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <opencv2/core/types.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace rtabmap_ros {
+
+/**
+ * Points hashed in cubic cells of size equal to the search radius. All
+ * neighbors of a query point in radius are then in the 27 cells around it,
+ * so radius queries are O(1) and adding points doesn't require any rebuild.
+ */
+class PointCloudVoxelHash
+{
+public:
+	PointCloudVoxelHash(float radius = 0.05f);
+
+	void setRadius(float radius); // clear the hash if radius has changed
+	float radius() const {return radius_;}
+	size_t size() const {return size_;}
+	bool empty() const {return size_ == 0;}
+	void clear();
+
+	// Add/remove the points [offset, offset+size[ of the cloud (size<0 means up to the end).
+	void addPoints(const pcl::PointCloud<pcl::PointXYZRGB> & cloud, int offset = 0, int size = -1);
+	void removePoints(const pcl::PointCloud<pcl::PointXYZRGB> & cloud, int offset = 0, int size = -1);
+
+	// Return the number of indexed points in radius of pt, stopping at maxNeighbors.
+	int radiusNeighbors(const pcl::PointXYZRGB & pt, int maxNeighbors) const;
+
+	// Return points of the cloud having less than minNeighborsInRadius indexed neighbors.
+	pcl::PointCloud<pcl::PointXYZRGB>::Ptr subtract(
+			const pcl::PointCloud<pcl::PointXYZRGB> & cloud,
+			int minNeighborsInRadius) const;
+
+private:
+	long long key(int x, int y, int z) const;
+	int cell(float v) const;
+
+private:
+	float radius_;
+	float radiusSqr_;
+	size_t size_;
+	std::unordered_map<long long, std::vector<cv::Point3f> > cells_;
+};
+
+} /* namespace rtabmap_ros */
+
+#endif /* POINTCLOUDVOXELHASH_H_ */
@@ -28,6 +28,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "rclcpp/rclcpp.hpp"
 
 #include <rtabmap_ros/OdometryROS.h>
+#include <rtabmap_ros/LaserScanConverter.h>
 #include <rtabmap_ros/visibility.h>
 
 //#include <pluginlib/class_list_macros.h>
@@ -73,6 +74,7 @@ private:
 	double scanVoxelSize_;
 	int scanNormalK_;
 	double scanNormalRadius_;
+	LaserScanConverter scanConverter_;
 	//std::vector<std::shared_ptr<rtabmap_ros::PluginInterface> > plugins_;
 	//pluginlib::ClassLoader<rtabmap_ros::PluginInterface> plugin_loader_;
 
@@ -37,6 +37,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <message_filters/subscriber.h>
 #include <message_filters/sync_policies/exact_time.h>
 
+#include <unordered_map>
+
 #include <rtabmap_ros/MsgConversion.h>
 #include <rtabmap/core/util3d.h>
 #include <rtabmap/core/util3d_filtering.h>
@@ -51,6 +53,10 @@ namespace rtabmap_ros
  * If fixed_frame_id is set to "" (empty), the nodelet will subscribe to
  * an odom topic that should have the exact same stamp than to input cloud.
  * The output cloud has the same stamp and frame than the last assembled cloud.
+ * If incremental is true (voxel_size should be set), each cloud is
+ * transformed in fixed_frame_id and added to a voxel map as soon as it is
+ * received, so only the voxels are kept in memory (xyz are averaged, other
+ * fields are the ones of the first point added to the voxel).
  */
 class PointCloudAssembler : public rclcpp::Node
 {
@@ -66,6 +72,8 @@ private:
 			const nav_msgs::msg::Odometry::ConstSharedPtr odomMsg);
 
 	void callbackCloud(const sensor_msgs::msg::PointCloud2::ConstSharedPtr cloudMsg);
+	void addCloudIncremental(const sensor_msgs::msg::PointCloud2::ConstSharedPtr & cloudMsg);
+	void clearIncremental();
 
 private:
 	std::thread * warningThread_;
@@ -92,6 +100,16 @@ private:
 	std::shared_ptr<tf2_ros::TransformListener> tfListener_;
 
 	std::vector<sensor_msgs::msg::PointCloud2::SharedPtr> clouds_;
+
+	bool incremental_;
+	int incrementalClouds_;
+	rclcpp::Time incrementalFirstStamp_;
+	std::vector<sensor_msgs::msg::PointField> incrementalFields_;
+	unsigned int incrementalPointStep_;
+	std::unordered_map<long long, int> voxelIndices_; // <voxel key, index>
+	std::vector<Eigen::Vector3f> voxelSums_;
+	std::vector<int> voxelCounts_;
+	std::vector<unsigned char> voxelData_; // point_step bytes per voxel
 };
 
 }
@@ -28,6 +28,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "rclcpp/rclcpp.hpp"
 
 #include <rtabmap_ros/OdometryROS.h>
+#include <rtabmap_ros/MsgConversion.h>
 #include <rtabmap_ros/visibility.h>
 
 #include <message_filters/subscriber.h>
@@ -115,6 +116,7 @@ private:
 	typedef message_filters::sync_policies::ExactTime<rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage> MyExactSync4Policy;
 	message_filters::Synchronizer<MyExactSync4Policy> * exactSync4_;
 	int queueSize_;
+	ImageBufferPool imagePool_;
 };
 
 }
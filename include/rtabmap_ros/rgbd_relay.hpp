@@ -45,6 +45,7 @@ private:
 private:
 	bool compress_;
 	bool uncompress_;
+	std::string depthCompression_;
 	rclcpp::Subscription<rtabmap_ros::msg::RGBDImage>::SharedPtr rgbdImageSub_;
 	rclcpp::Publisher<rtabmap_ros::msg::RGBDImage>::SharedPtr rgbdImagePub_;
 };
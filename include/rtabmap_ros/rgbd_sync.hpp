@@ -39,6 +39,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <message_filters/subscriber.h>
 
 #include "rtabmap_ros/msg/rgbd_image.hpp"
+#include "rtabmap_ros/msg/latency_trace.hpp"
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
 
 namespace rtabmap_ros
 {
@@ -56,18 +62,43 @@ public:
 			const sensor_msgs::msg::Image::ConstSharedPtr depth,
 			const sensor_msgs::msg::CameraInfo::ConstSharedPtr cameraInfo);
 
+private:
+	struct CompressionJob
+	{
+		rtabmap_ros::msg::RGBDImage::UniquePtr msg; // without images
+		sensor_msgs::msg::Image::ConstSharedPtr image;
+		sensor_msgs::msg::Image::ConstSharedPtr depth;
+		rclcpp::Time queued;
+	};
+	void compressionLoop();
+	void compress(CompressionJob & job);
+
 private:
 	double depthScale_;
 	double compressedRate_;
+	std::string depthCompression_;
 	bool callbackCalled_;
 
-	rclcpp::Time lastCompressedPublished_;
+	double lastCompressedStamp_;
+	bool latencyTrace_;
+
+	// Compression is done out of the sync callback by a pool of workers
+	std::vector<std::thread*> compressionThreads_;
+	std::list<CompressionJob> compressionQueue_;
+	unsigned int compressionQueueSize_;
+	int compressionDropped_;
+	rclcpp::Time lastCompressionDropWarning_;
+	bool compressionStop_;
+	std::mutex compressionMutex_;
+	std::condition_variable compressionCondition_;
 
 	std::thread * warningThread_;
 	std::string subscribedTopicsMsg_;
 
 	rclcpp::Publisher<rtabmap_ros::msg::RGBDImage>::SharedPtr rgbdImagePub_;
 	rclcpp::Publisher<rtabmap_ros::msg::RGBDImage>::SharedPtr rgbdImageCompressedPub_;
+	rclcpp::Publisher<rtabmap_ros::msg::LatencyTrace>::SharedPtr latencyTracePub_;
+	rclcpp::Publisher<rtabmap_ros::msg::LatencyTrace>::SharedPtr compressedLatencyTracePub_;
 
 	image_transport::SubscriberFilter imageSub_;
 	image_transport::SubscriberFilter imageDepthSub_;
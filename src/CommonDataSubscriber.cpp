@@ -33,6 +33,8 @@ namespace rtabmap_ros {
 CommonDataSubscriber::CommonDataSubscriber(rclcpp::Node& node, bool gui) :
 		queueSize_(10),
 		approxSync_(true),
+		syncSlack_(0.0),
+		syncAddedLatency_(0.0),
 		warningThread_(0),
 		callbackCalled_(false),
 		subscribedToDepth_(!gui),
@@ -337,11 +339,29 @@ CommonDataSubscriber::CommonDataSubscriber(rclcpp::Node& node, bool gui) :
 	rgbdCameras_ = node.declare_parameter("rgbd_cameras", rgbdCameras_);
 	queueSize_ = node.declare_parameter("queue_size", queueSize_);
 	approxSync_ = node.declare_parameter("approx_sync", approxSync_);
+	syncSlack_ = node.declare_parameter("approx_sync_slack", syncSlack_);
 
 	if(rgbdCameras_ <= 0 && subscribedToRGBD_)
 	{
 		rgbdCameras_ = 1;
 	}
+#ifndef RTABMAP_SYNC_MULTI_RGBD
+	if(subscribedToRGBD_ && rgbdCameras_ > 1)
+	{
+		RCLCPP_FATAL(node.get_logger(), "%s: Cannot synchronize more than 1 rgbd camera (rgbd_cameras=%d), rtabmap_ros has been built "
+				"without RTABMAP_SYNC_MULTI_RGBD option. Rebuild with -DRTABMAP_SYNC_MULTI_RGBD=ON to use more cameras.",
+				name_.c_str(), rgbdCameras_);
+	}
+#endif
+#ifndef RTABMAP_SYNC_USER_DATA
+	if(subscribedToUserData_)
+	{
+		RCLCPP_ERROR(node.get_logger(), "%s: Cannot synchronize user data, rtabmap_ros has been built without RTABMAP_SYNC_USER_DATA "
+				"option. Rebuild with -DRTABMAP_SYNC_USER_DATA=ON to use it. Parameter subscribe_user_data is set to false.",
+				name_.c_str());
+		subscribedToUserData_ = false;
+	}
+#endif
 
 	RCLCPP_INFO(node.get_logger(), "%s: subscribe_depth = %s", name_.c_str(), subscribedToDepth_?"true":"false");
 	RCLCPP_INFO(node.get_logger(), "%s: subscribe_rgb = %s", name_.c_str(), subscribedToRGB_?"true":"false");
@@ -353,6 +373,10 @@ CommonDataSubscriber::CommonDataSubscriber(rclcpp::Node& node, bool gui) :
 	RCLCPP_INFO(node.get_logger(), "%s: subscribe_scan_cloud = %s", name_.c_str(), subscribedToScan3d_?"true":"false");
 	RCLCPP_INFO(node.get_logger(), "%s: queue_size    = %d", name_.c_str(), queueSize_);
 	RCLCPP_INFO(node.get_logger(), "%s: approx_sync   = %s", name_.c_str(), approxSync_?"true":"false");
+	if(approxSync_)
+	{
+		RCLCPP_INFO(node.get_logger(), "%s: approx_sync_slack = %f s", name_.c_str(), syncSlack_);
+	}
 
 	subscribedToOdom_ = odomFrameId.empty() && subscribeOdom;
 }
@@ -394,6 +418,7 @@ void CommonDataSubscriber::setupCallbacks(rclcpp::Node & node)
 	}
 	else if(subscribedToRGBD_)
 	{
+#ifdef RTABMAP_SYNC_MULTI_RGBD
 		if(rgbdCameras_ == 4)
 		{
 			setupRGBD4Callbacks(
@@ -431,6 +456,9 @@ void CommonDataSubscriber::setupCallbacks(rclcpp::Node & node)
 					approxSync_);
 		}
 		else
+#else
+		if(rgbdCameras_ == 1)
+#endif
 		{
 			setupRGBDCallbacks(
 					node,
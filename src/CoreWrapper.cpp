@@ -109,6 +109,26 @@ CoreWrapper::CoreWrapper(const rclcpp::NodeOptions & options) :
 		genScanMinDepth_(0.0),
 		scanCloudMaxPoints_(0),
 		mapToOdom_(rtabmap::Transform::getIdentity()),
+		mapsUpdateAsync_(false),
+		mapsGridFromDepth_(false),
+		mapsUpdateQueueSize_(1),
+		mapsUpdateThread_(0),
+		mapsUpdateThreadRunning_(false),
+		mapsUpdateDropped_(0),
+		mapsUpdateLastTimeUpdate_(0.0),
+		mapsUpdateLastTimePublish_(0.0),
+		mapsUpdateLastId_(0),
+		tfPrefetch_(false),
+		tfPrefetchMaxFrames_(5),
+		tfPrefetchProcessing_(false),
+		latencyTrace_(false),
+		latencyInputTime_(0.0),
+		latencyTFTime_(0.0),
+		mapDataSubscriptions_(0),
+		mapGraphSubscriptions_(0),
+		mapDataPageSize_(20),
+		mapDataPageSessionId_(0),
+		infoGroups_(kInfoFull),
 		transformThread_(0),
 		tfThreadRunning_(false),
 		interOdomSync_(0),
@@ -173,6 +193,58 @@ CoreWrapper::CoreWrapper(const rclcpp::NodeOptions & options) :
 	stereoToDepth_ = this->declare_parameter("stereo_to_depth", stereoToDepth_);
 	odomSensorSync_ = this->declare_parameter("odom_sensor_sync", odomSensorSync_);
 
+	mapsUpdateAsync_ = this->declare_parameter("map_update_async", mapsUpdateAsync_);
+	mapsUpdateQueueSize_ = this->declare_parameter("map_update_queue_size", mapsUpdateQueueSize_);
+	if(mapsUpdateQueueSize_ < 1)
+	{
+		RCLCPP_WARN(this->get_logger(), "map_update_queue_size should be >= 1, setting it to 1.");
+		mapsUpdateQueueSize_ = 1;
+	}
+	tfPrefetch_ = this->declare_parameter("tf_prefetch", tfPrefetch_);
+	tfPrefetchMaxFrames_ = this->declare_parameter("tf_prefetch_max_frames", tfPrefetchMaxFrames_);
+	if(tfPrefetchMaxFrames_ < 1)
+	{
+		RCLCPP_WARN(this->get_logger(), "tf_prefetch_max_frames should be >= 1, setting it to 1.");
+		tfPrefetchMaxFrames_ = 1;
+	}
+	latencyTrace_ = this->declare_parameter("latency_trace", latencyTrace_);
+	int latencyTraceSize = this->declare_parameter("latency_trace_size", 1000);
+	latencyTraceFile_ = this->declare_parameter("latency_trace_file", latencyTraceFile_);
+	int nodeDataCacheSize = this->declare_parameter("node_data_cache_size", 0);
+	nodeDataCache_.setCapacity(nodeDataCacheSize>0?nodeDataCacheSize:0);
+	int mapDeltaKeyframeInterval = this->declare_parameter("map_delta_keyframe_interval", 0);
+	mapDataDeltaEncoder_.setKeyframeInterval(mapDeltaKeyframeInterval);
+	mapGraphDeltaEncoder_.setKeyframeInterval(mapDeltaKeyframeInterval);
+	mapDataPageSize_ = this->declare_parameter("map_data_page_size", mapDataPageSize_);
+	// Statistics groups published on "info". The default "full" is for
+	// rtabmapviz and older consumers. Nodes needing only timings or loop
+	// closure statistics should subscribe to "info/timings" or
+	// "info/loop_closure" instead, then "info" can be set to "none".
+	std::string infoStatistics = this->declare_parameter("info_statistics", std::string("full"));
+	std::list<std::string> infoGroups = uSplit(uToLowerCase(infoStatistics), ',');
+	infoGroups_ = kInfoNone;
+	for(std::list<std::string>::iterator iter=infoGroups.begin(); iter!=infoGroups.end(); ++iter)
+	{
+		std::string group = uReplaceChar(*iter, ' ', "");
+		if(group.compare("full") == 0)
+		{
+			infoGroups_ |= kInfoFull;
+		}
+		else if(group.compare("timings") == 0)
+		{
+			infoGroups_ |= kInfoTimings;
+		}
+		else if(group.compare("loop_closure") == 0)
+		{
+			infoGroups_ |= kInfoLoopClosure;
+		}
+		else if(!group.empty() && group.compare("none") != 0)
+		{
+			RCLCPP_WARN(this->get_logger(), "rtabmap: Unknown statistics group \"%s\" in info_statistics parameter (\"%s\"), "
+					"valid groups are \"full\", \"timings\", \"loop_closure\" or \"none\".", group.c_str(), infoStatistics.c_str());
+		}
+	}
+
 	RCLCPP_INFO(this->get_logger(), "rtabmap: frame_id      = %s", frameId_.c_str());
 	if(!odomFrameId_.empty())
 	{
@@ -189,12 +261,36 @@ CoreWrapper::CoreWrapper(const rclcpp::NodeOptions & options) :
 	RCLCPP_INFO(this->get_logger(), "rtabmap: tf_delay      = %f", tfDelay);
 	RCLCPP_INFO(this->get_logger(), "rtabmap: tf_tolerance  = %f", tfTolerance);
 	RCLCPP_INFO(this->get_logger(), "rtabmap: odom_sensor_sync   = %s", odomSensorSync_?"true":"false");
+	RCLCPP_INFO(this->get_logger(), "rtabmap: map_update_async   = %s", mapsUpdateAsync_?"true":"false");
+	if(mapsUpdateAsync_)
+	{
+		RCLCPP_INFO(this->get_logger(), "rtabmap: map_update_queue_size = %d", mapsUpdateQueueSize_);
+	}
+	RCLCPP_INFO(this->get_logger(), "rtabmap: tf_prefetch        = %s", tfPrefetch_?"true":"false");
+	if(tfPrefetch_)
+	{
+		RCLCPP_INFO(this->get_logger(), "rtabmap: tf_prefetch_max_frames = %d", tfPrefetchMaxFrames_);
+	}
+	RCLCPP_INFO(this->get_logger(), "rtabmap: latency_trace      = %s", latencyTrace_?"true":"false");
+	if(latencyTrace_)
+	{
+		RCLCPP_INFO(this->get_logger(), "rtabmap: latency_trace_size = %d", latencyTraceSize);
+		RCLCPP_INFO(this->get_logger(), "rtabmap: latency_trace_file = %s", latencyTraceFile_.c_str());
+		latencyTracer_.setCapacity(latencyTraceSize>0?latencyTraceSize:1);
+		latencyTracePub_ = this->create_publisher<rtabmap_ros::msg::LatencyTrace>("latency_trace", 1);
+	}
+	RCLCPP_INFO(this->get_logger(), "rtabmap: node_data_cache_size = %d", (int)nodeDataCache_.capacity());
+	RCLCPP_INFO(this->get_logger(), "rtabmap: map_delta_keyframe_interval = %d", mapDataDeltaEncoder_.keyframeInterval());
+	RCLCPP_INFO(this->get_logger(), "rtabmap: map_data_page_size = %d", mapDataPageSize_);
+	RCLCPP_INFO(this->get_logger(), "rtabmap: info_statistics = %s", infoStatistics.c_str());
 	if(this->isSubscribedToStereo())
 	{
 		RCLCPP_INFO(this->get_logger(), "rtabmap: stereo_to_depth = %s", stereoToDepth_?"true":"false");
 	}
 
 	infoPub_ = this->create_publisher<rtabmap_ros::msg::Info>("info", 1);
+	infoTimingsPub_ = this->create_publisher<rtabmap_ros::msg::Info>("info/timings", 1);
+	infoLoopClosurePub_ = this->create_publisher<rtabmap_ros::msg::Info>("info/loop_closure", 1);
 	mapDataPub_ = this->create_publisher<rtabmap_ros::msg::MapData>("mapData", 1);
 	mapGraphPub_ = this->create_publisher<rtabmap_ros::msg::MapGraph>("mapGraph", 1);
 	landmarksPub_ = this->create_publisher<geometry_msgs::msg::PoseArray>("landmarks", 1);
@@ -507,6 +603,7 @@ CoreWrapper::CoreWrapper(const rclcpp::NodeOptions & options) :
 	}
 
 	mapsManager_.setParameters(parameters_);
+	mapsGridFromDepth_ = mapsManager_.getOccupancyGrid()->isGridFromDepth();
 
 	// Init RTAB-Map
 	rtabmap_.init(parameters_, databasePath_);
@@ -536,6 +633,7 @@ CoreWrapper::CoreWrapper(const rclcpp::NodeOptions & options) :
 	setModeLocalizationSrv_ = this->create_service<std_srvs::srv::Empty>("set_mode_localization", std::bind(&CoreWrapper::setModeLocalizationCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	setModeMappingSrv_ = this->create_service<std_srvs::srv::Empty>("set_mode_mapping", std::bind(&CoreWrapper::setModeMappingCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	getMapDataSrv_ = this->create_service<rtabmap_ros::srv::GetMap>("get_map_data", std::bind(&CoreWrapper::getMapDataCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+	getMapDataPageSrv_ = this->create_service<rtabmap_ros::srv::GetMapPage>("get_map_data_page", std::bind(&CoreWrapper::getMapDataPageCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	getMapSrv_ = this->create_service<nav_msgs::srv::GetMap>("get_map", std::bind(&CoreWrapper::getMapCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	getProbMapSrv_ = this->create_service<nav_msgs::srv::GetMap>("get_prob_map", std::bind(&CoreWrapper::getProbMapCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 	publishMapDataSrv_ = this->create_service<rtabmap_ros::srv::PublishMap>("publish_map", std::bind(&CoreWrapper::publishMapCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
@@ -592,6 +690,18 @@ CoreWrapper::CoreWrapper(const rclcpp::NodeOptions & options) :
 				Parameters::kOptimizerIterations().c_str(), mapFrameId_.c_str());
 	}
 
+	if(mapsUpdateAsync_)
+	{
+		mapsUpdateThreadRunning_ = true;
+		mapsUpdateThread_ = new std::thread(&CoreWrapper::mapsUpdateThread, this);
+	}
+
+	if(tfPrefetch_)
+	{
+		// same (default) callback group than data callbacks, so deferred frames are never processed concurrently
+		tfPrefetchTimer_ = this->create_wall_timer(std::chrono::milliseconds(5), std::bind(&CoreWrapper::tfPrefetchCallback, this));
+	}
+
 	RCLCPP_INFO(this->get_logger(), "Setup callbacks");
 	setupCallbacks(*this); // do it at the end
 	if(!this->isDataSubscribed())
@@ -698,8 +808,13 @@ CoreWrapper::CoreWrapper(const rclcpp::NodeOptions & options) :
 					rate_ = uStr2Float(parameters_.at(Parameters::kRtabmapDetectionRate()));
 					RCLCPP_INFO(this->get_logger(), "RTAB-Map rate detection = %f Hz", rate_);
 				}
+				mapsMutex_.lock();
+				memoryMutex_.lock();
 				rtabmap_.parseParameters(parameters_);
+				memoryMutex_.unlock();
 				mapsManager_.setParameters(parameters_);
+				mapsGridFromDepth_ = mapsManager_.getOccupancyGrid()->isGridFromDepth();
+				mapsMutex_.unlock();
 			};
 
 	// Setup callback for changes to parameters.
@@ -715,6 +830,21 @@ CoreWrapper::~CoreWrapper()
 		delete transformThread_;
 	}
 
+	if(mapsUpdateThread_)
+	{
+		mapsUpdateQueueMutex_.lock();
+		mapsUpdateThreadRunning_ = false;
+		mapsUpdateQueueMutex_.unlock();
+		mapsUpdateQueueCondition_.notify_one();
+		mapsUpdateThread_->join();
+		delete mapsUpdateThread_;
+	}
+
+	if(latencyTrace_ && !latencyTraceFile_.empty())
+	{
+		latencyTracer_.exportFile(latencyTraceFile_, this->get_name());
+	}
+
 	this->saveParameters(configPath_);
 
 	printf("rtabmap: Saving database/long-term memory... (located at %s)\n", databasePath_.c_str());
@@ -814,7 +944,10 @@ void CoreWrapper::defaultCallback(const sensor_msgs::msg::Image::ConstSharedPtr
 		UTimer timer;
 		if(rtabmap_.isIDsGenerated())
 		{
-			if(!rtabmap_.process(ptrImage->image.clone()))
+			memoryMutex_.lock();
+			bool processed = rtabmap_.process(ptrImage->image.clone());
+			memoryMutex_.unlock();
+			if(!processed)
 			{
 				RCLCPP_WARN(this->get_logger(), "RTAB-Map could not process the data received!");
 			}
@@ -935,11 +1068,174 @@ bool CoreWrapper::odomUpdate(const nav_msgs::msg::Odometry & odomMsg, rclcpp::Ti
 			previousStamp_ = stamp;
 		}
 
+		if(latencyTrace_)
+		{
+			latencyTFTime_ = now().seconds();
+		}
+
+		return true;
+	}
+	return false;
+}
+
+bool CoreWrapper::tfPrefetchAvailable(const std::vector<TFPrefetchRequest> & transforms, std::string * missing, bool requiredOnly) const
+{
+	for(unsigned int i=0; i<transforms.size(); ++i)
+	{
+		if((!requiredOnly || !transforms[i].optional) &&
+		   transforms[i].targetFrame.compare(transforms[i].sourceFrame) != 0 &&
+		   !tfBuffer_->canTransform(transforms[i].targetFrame, transforms[i].sourceFrame, tf2_ros::fromMsg(transforms[i].stamp), tf2::durationFromSec(0.0)))
+		{
+			if(missing)
+			{
+				*missing = uFormat("%s -> %s at %fs", transforms[i].targetFrame.c_str(), transforms[i].sourceFrame.c_str(), transforms[i].stamp.seconds());
+			}
+			return false;
+		}
+	}
+	return true;
+}
+
+bool CoreWrapper::tfPrefetchReady(const std::vector<TFPrefetchRequest> & transforms, const std::function<void()> & callback)
+{
+	// keep frames in order
+	if(tfPrefetchFrames_.empty() && tfPrefetchAvailable(transforms))
+	{
 		return true;
 	}
+
+	if((int)tfPrefetchFrames_.size() >= tfPrefetchMaxFrames_)
+	{
+		RCLCPP_WARN(this->get_logger(), "Too many frames waiting for TF (tf_prefetch_max_frames=%d), dropping oldest one.", tfPrefetchMaxFrames_);
+		tfPrefetchFrames_.pop_front();
+	}
+	TFPrefetchFrame frame;
+	frame.transforms = transforms;
+	frame.callback = callback;
+	frame.deferredTime = UTimer::now();
+	frame.inputTime = latencyInputTime_;
+	tfPrefetchFrames_.push_back(frame);
 	return false;
 }
 
+void CoreWrapper::tfPrefetchCallback()
+{
+	while(!tfPrefetchFrames_.empty())
+	{
+		std::string missing;
+		if(tfPrefetchAvailable(tfPrefetchFrames_.front().transforms, &missing))
+		{
+			std::function<void()> callback = tfPrefetchFrames_.front().callback;
+			latencyInputTime_ = tfPrefetchFrames_.front().inputTime;
+			tfPrefetchFrames_.pop_front();
+			tfPrefetchProcessing_ = true;
+			callback();
+			tfPrefetchProcessing_ = false;
+		}
+		else if(UTimer::now() - tfPrefetchFrames_.front().deferredTime > waitForTransform_)
+		{
+			if(tfPrefetchAvailable(tfPrefetchFrames_.front().transforms, 0, true))
+			{
+				// only optional transforms (e.g., ground truth, global pose correction) are missing
+				std::function<void()> callback = tfPrefetchFrames_.front().callback;
+				latencyInputTime_ = tfPrefetchFrames_.front().inputTime;
+				tfPrefetchFrames_.pop_front();
+				tfPrefetchProcessing_ = true;
+				callback();
+				tfPrefetchProcessing_ = false;
+			}
+			else
+			{
+				RCLCPP_WARN(this->get_logger(), "Dropping frame, TF %s not available after %fs (wait_for_transform).", missing.c_str(), waitForTransform_);
+				tfPrefetchFrames_.pop_front();
+			}
+		}
+		else
+		{
+			break;
+		}
+	}
+}
+
+std::vector<CoreWrapper::TFPrefetchRequest> CoreWrapper::tfPrefetchRequests(
+		const nav_msgs::msg::Odometry::ConstSharedPtr & odomMsg,
+		const rclcpp::Time & poseStamp,
+		const std::vector<std::pair<std::string, rclcpp::Time> > & sensors,
+		const sensor_msgs::msg::LaserScan::ConstSharedPtr& scan2dMsg,
+		const sensor_msgs::msg::PointCloud2::ConstSharedPtr& scan3dMsg) const
+{
+	std::vector<TFPrefetchRequest> transforms;
+	std::string odomFrameId = odomMsg.get()?odomMsg->header.frame_id:odomFrameId_;
+	std::string syncFrameId = odomSensorSync_?odomFrameId:"";
+
+	// odomUpdate()/odomTFUpdate()
+	if(odomMsg.get())
+	{
+		// odomUpdate() falls back on the odometry msg pose if not available
+		transforms.push_back({odomMsg->header.frame_id, frameId_, poseStamp, true});
+	}
+	else if(!odomFrameId_.empty())
+	{
+		transforms.push_back({odomFrameId_, frameId_, poseStamp, false});
+	}
+
+	// convert*Msg(): local transforms at sensor stamp, and with odom_sensor_sync,
+	// the movement of the base frame in odom frame between the sensor stamp and the pose stamp
+	std::vector<rclcpp::Time> sensorStamps;
+	for(unsigned int i=0; i<sensors.size(); ++i)
+	{
+		transforms.push_back({frameId_, sensors[i].first, sensors[i].second, false});
+		sensorStamps.push_back(sensors[i].second);
+	}
+	if(scan2dMsg.get())
+	{
+		rclcpp::Time stamp = scan2dMsg->header.stamp;
+		std::string targetFrame = syncFrameId.empty()?frameId_:syncFrameId;
+		transforms.push_back({targetFrame, scan2dMsg->header.frame_id, stamp + rclcpp::Duration(scan2dMsg->ranges.size()*scan2dMsg->time_increment*10e9), false});
+		transforms.push_back({targetFrame, scan2dMsg->header.frame_id, stamp, false});
+		transforms.push_back({frameId_, scan2dMsg->header.frame_id, stamp, false});
+		sensorStamps.push_back(stamp);
+	}
+	if(scan3dMsg.get())
+	{
+		transforms.push_back({frameId_, scan3dMsg->header.frame_id, scan3dMsg->header.stamp, false});
+		sensorStamps.push_back(scan3dMsg->header.stamp);
+	}
+	if(!syncFrameId.empty())
+	{
+		bool poseStampAdded = false;
+		for(unsigned int i=0; i<sensorStamps.size(); ++i)
+		{
+			if(sensorStamps[i] != poseStamp)
+			{
+				// a warning is shown if not available
+				transforms.push_back({syncFrameId, frameId_, sensorStamps[i], true});
+				if(!poseStampAdded)
+				{
+					transforms.push_back({syncFrameId, frameId_, poseStamp, true});
+					poseStampAdded = true;
+				}
+			}
+		}
+	}
+
+	// process()
+	if(!groundTruthFrameId_.empty())
+	{
+		transforms.push_back({groundTruthFrameId_, groundTruthBaseFrameId_, poseStamp, true});
+	}
+	if(globalPose_.header.stamp.sec != 0 || globalPose_.header.stamp.nanosec != 0)
+	{
+		transforms.push_back({globalPose_.header.frame_id, frameId_, poseStamp, true});
+		if(!odomFrameId.empty())
+		{
+			transforms.push_back({odomFrameId, frameId_, rclcpp::Time(globalPose_.header.stamp.sec, globalPose_.header.stamp.nanosec), true});
+			transforms.push_back({odomFrameId, frameId_, poseStamp, true});
+		}
+	}
+	return transforms;
+}
+
 bool CoreWrapper::odomTFUpdate(const rclcpp::Time & stamp)
 {
 	if(!paused_)
@@ -991,6 +1287,11 @@ bool CoreWrapper::odomTFUpdate(const rclcpp::Time & stamp)
 			previousStamp_ = stamp;
 		}
 
+		if(latencyTrace_)
+		{
+			latencyTFTime_ = now().seconds();
+		}
+
 		return true;
 	}
 	return false;
@@ -1006,6 +1307,34 @@ void CoreWrapper::commonDepthCallback(
 		const sensor_msgs::msg::PointCloud2::ConstSharedPtr& scan3dMsg,
 		const rtabmap_ros::msg::OdomInfo::ConstSharedPtr& odomInfoMsg)
 {
+	if(latencyTrace_ && !tfPrefetchProcessing_)
+	{
+		latencyInputTime_ = now().seconds();
+	}
+	if(tfPrefetch_ && !tfPrefetchProcessing_)
+	{
+		rclcpp::Time stamp = scan2dMsg.get()?rclcpp::Time(scan2dMsg->header.stamp):
+				scan3dMsg.get()?rclcpp::Time(scan3dMsg->header.stamp):
+				imageMsgs.size() && imageMsgs[0].get()?rclcpp::Time(imageMsgs[0]->header.stamp):rclcpp::Time(0);
+		std::vector<std::pair<std::string, rclcpp::Time> > cameras;
+		for(unsigned int i=0; i<imageMsgs.size(); ++i)
+		{
+			if(imageMsgs[i].get())
+			{
+				// convertRGBDMsgs() uses the depth stamp if set
+				cameras.push_back(std::make_pair(imageMsgs[i]->header.frame_id,
+					i<depthMsgs.size() && depthMsgs[i].get()?rclcpp::Time(depthMsgs[i]->header.stamp):rclcpp::Time(imageMsgs[i]->header.stamp)));
+			}
+		}
+		std::vector<TFPrefetchRequest> transforms = tfPrefetchRequests(odomMsg, stamp, cameras, scan2dMsg, scan3dMsg);
+		if(!tfPrefetchReady(transforms, [=](){
+				this->commonDepthCallback(odomMsg, userDataMsg, imageMsgs, depthMsgs, cameraInfoMsgs, scan2dMsg, scan3dMsg, odomInfoMsg);
+			}))
+		{
+			return;
+		}
+	}
+
 	std::string odomFrameId = odomFrameId_;
 	if(odomMsg.get())
 	{
@@ -1082,7 +1411,8 @@ void CoreWrapper::commonDepthCallbackImpl(
 			depth,
 			cameraModels,
 			*tfBuffer_,
-			waitForTransform_))
+			waitForTransform_,
+			&imagePool_))
 	{
 		RCLCPP_ERROR(this->get_logger(), "Could not convert rgb/depth msgs! Aborting rtabmap update...");
 		return;
@@ -1203,6 +1533,25 @@ void CoreWrapper::commonStereoCallback(
 		const sensor_msgs::msg::PointCloud2::ConstSharedPtr& scan3dMsg,
 		const rtabmap_ros::msg::OdomInfo::ConstSharedPtr& odomInfoMsg)
 {
+	if(latencyTrace_ && !tfPrefetchProcessing_)
+	{
+		latencyInputTime_ = now().seconds();
+	}
+	if(tfPrefetch_ && !tfPrefetchProcessing_ && leftImageMsg.get())
+	{
+		rclcpp::Time stamp = scan2dMsg.get()?rclcpp::Time(scan2dMsg->header.stamp):
+				scan3dMsg.get()?rclcpp::Time(scan3dMsg->header.stamp):rclcpp::Time(leftImageMsg->header.stamp);
+		std::vector<std::pair<std::string, rclcpp::Time> > cameras;
+		cameras.push_back(std::make_pair(leftImageMsg->header.frame_id, rclcpp::Time(leftImageMsg->header.stamp)));
+		std::vector<TFPrefetchRequest> transforms = tfPrefetchRequests(odomMsg, stamp, cameras, scan2dMsg, scan3dMsg);
+		if(!tfPrefetchReady(transforms, [=](){
+				this->commonStereoCallback(odomMsg, userDataMsg, leftImageMsg, rightImageMsg, leftCamInfoMsg, rightCamInfoMsg, scan2dMsg, scan3dMsg, odomInfoMsg);
+			}))
+		{
+			return;
+		}
+	}
+
 	std::string odomFrameId = odomFrameId_;
 	if(odomMsg.get())
 	{
@@ -1399,6 +1748,22 @@ void CoreWrapper::commonLaserScanCallback(
 		const rtabmap_ros::msg::OdomInfo::ConstSharedPtr& odomInfoMsg)
 {
 	UASSERT(scan2dMsg.get() || scan3dMsg.get());
+	if(latencyTrace_ && !tfPrefetchProcessing_)
+	{
+		latencyInputTime_ = now().seconds();
+	}
+	if(tfPrefetch_ && !tfPrefetchProcessing_)
+	{
+		rclcpp::Time stamp = scan2dMsg.get()?rclcpp::Time(scan2dMsg->header.stamp):rclcpp::Time(scan3dMsg->header.stamp);
+		std::vector<TFPrefetchRequest> transforms = tfPrefetchRequests(odomMsg, stamp, std::vector<std::pair<std::string, rclcpp::Time> >(), scan2dMsg, scan3dMsg);
+		if(!tfPrefetchReady(transforms, [=](){
+				this->commonLaserScanCallback(odomMsg, userDataMsg, scan2dMsg, scan3dMsg, odomInfoMsg);
+			}))
+		{
+			return;
+		}
+	}
+
 	std::string odomFrameId = odomFrameId_;
 	if(odomMsg.get())
 	{
@@ -1536,6 +1901,26 @@ void CoreWrapper::commonOdomCallback(
 		const rtabmap_ros::msg::OdomInfo::ConstSharedPtr& odomInfoMsg)
 {
 	UASSERT(odomMsg.get());
+	if(latencyTrace_ && !tfPrefetchProcessing_)
+	{
+		latencyInputTime_ = now().seconds();
+	}
+	if(tfPrefetch_ && !tfPrefetchProcessing_)
+	{
+		std::vector<TFPrefetchRequest> transforms = tfPrefetchRequests(
+				odomMsg,
+				odomMsg->header.stamp,
+				std::vector<std::pair<std::string, rclcpp::Time> >(),
+				sensor_msgs::msg::LaserScan::ConstSharedPtr(),
+				sensor_msgs::msg::PointCloud2::ConstSharedPtr());
+		if(!tfPrefetchReady(transforms, [=](){
+				this->commonOdomCallback(odomMsg, userDataMsg, odomInfoMsg);
+			}))
+		{
+			return;
+		}
+	}
+
 	std::string odomFrameId = odomFrameId_;
 
 	odomFrameId = odomMsg->header.frame_id;
@@ -1606,6 +1991,7 @@ void CoreWrapper::process(
 		const OdometryInfo & odomInfo)
 {
 	UTimer timer;
+	rclcpp::Time timeStart = now();
 	if(rtabmap_.isIDsGenerated() || data.id() > 0)
 	{
 		// Add intermediate nodes?
@@ -1684,7 +2070,9 @@ void CoreWrapper::process(
 						}
 					}
 
+					memoryMutex_.lock();
 					rtabmap_.process(interData, interOdom, covariance, odomVelocity, externalStats);
+					memoryMutex_.unlock();
 				}
 				interOdoms_.erase(iter++);
 			}
@@ -1836,7 +2224,10 @@ void CoreWrapper::process(
 			rtabmapROSStats_.clear();
 		}
 
-		if(rtabmap_.process(data, odom, covariance, odomVelocity, externalStats))
+		memoryMutex_.lock();
+		bool processed = rtabmap_.process(data, odom, covariance, odomVelocity, externalStats);
+		memoryMutex_.unlock();
+		if(processed)
 		{
 			timeRtabmap = timer.ticks();
 			mapToOdomMutex_.lock();
@@ -1866,13 +2257,17 @@ void CoreWrapper::process(
 				std::map<int, rtabmap::Transform> filteredPoses(rtabmap_.getLocalOptimizedPoses().lower_bound(1), rtabmap_.getLocalOptimizedPoses().end());
 
 				// create a tmp signature with latest sensory data if latest signature was ignored
+				// (memory can be accessed at the same time by mapsUpdateThread_)
 				std::map<int, rtabmap::Signature> tmpSignature;
-				if(rtabmap_.getMemory() == 0 ||
+				memoryMutex_.lock();
+				bool addTmpSignature = rtabmap_.getMemory() == 0 ||
 					filteredPoses.size() == 0 ||
 					rtabmap_.getMemory()->getLastSignatureId() != filteredPoses.rbegin()->first ||
 					rtabmap_.getMemory()->getLastWorkingSignature() == 0 ||
 					rtabmap_.getMemory()->getLastWorkingSignature()->sensorData().gridCellSize() == 0 ||
-					(!mapsManager_.getOccupancyGrid()->isGridFromDepth() && data.laserScanRaw().is2d())) // 2d laser scan would fill empty space for latest data
+					(!mapsGridFromDepth_ && data.laserScanRaw().is2d()); // 2d laser scan would fill empty space for latest data
+				memoryMutex_.unlock();
+				if(addTmpSignature)
 				{
 					SensorData tmpData = data;
 					tmpData.setId(0);
@@ -1914,17 +2309,51 @@ void CoreWrapper::process(
 					filteredPoses = nearestPoses;
 				}
 
-				// Update maps
-				filteredPoses = mapsManager_.updateMapCaches(
-						filteredPoses,
-						rtabmap_.getMemory(),
-						false,
-						false,
-						tmpSignature);
-
-				timeUpdateMaps = timer.ticks();
-
-				mapsManager_.publishMaps(filteredPoses, stamp, mapFrameId_);
+				if(mapsUpdateAsync_)
+				{
+					// Update and publish maps in mapsUpdateThread_, keep only
+					// the latest requests if it cannot follow SLAM rate
+					MapsUpdateRequest request;
+					request.stamp = stamp;
+					request.mapFrameId = mapFrameId_;
+					request.poses = filteredPoses;
+					request.signatures = tmpSignature;
+					request.id = rtabmap_.getLastLocationId();
+					mapsUpdateQueueMutex_.lock();
+					while((int)mapsUpdateQueue_.size() >= mapsUpdateQueueSize_)
+					{
+						mapsUpdateQueue_.pop_front();
+						++mapsUpdateDropped_;
+					}
+					mapsUpdateQueue_.push_back(request);
+					rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/MapsUpdateDropped/"), (float)mapsUpdateDropped_));
+					if(mapsUpdateLastId_ > 0)
+					{
+						// Last update done by mapsUpdateThread(), for node AsyncMapsNodeId
+						rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/TimeAsyncMapsUpdate/ms"), mapsUpdateLastTimeUpdate_*1000.0f));
+						rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/TimeAsyncMapsPublish/ms"), mapsUpdateLastTimePublish_*1000.0f));
+						rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/AsyncMapsNodeId/"), (float)mapsUpdateLastId_));
+					}
+					mapsUpdateQueueMutex_.unlock();
+					mapsUpdateQueueCondition_.notify_one();
+					// only the hand-off to mapsUpdateThread() for this frame
+					timeUpdateMaps = timer.ticks();
+				}
+				else
+				{
+					// Update maps
+					std::lock_guard<std::mutex> mapsLock(mapsMutex_);
+					filteredPoses = mapsManager_.updateMapCaches(
+							filteredPoses,
+							rtabmap_.getMemory(),
+							false,
+							false,
+							tmpSignature);
+
+					timeUpdateMaps = timer.ticks();
+
+					mapsManager_.publishMaps(filteredPoses, stamp, mapFrameId_);
+				}
 
 				// update goal if planning is enabled
 				if(!currentMetricGoal_.isNull())
@@ -2016,6 +2445,8 @@ void CoreWrapper::process(
 					}
 				}
 
+				// With map_update_async, only goal and paths of this frame,
+				// maps are published by mapsUpdateThread()
 				timePublishMaps = timer.ticks();
 			}
 		}
@@ -2037,6 +2468,44 @@ void CoreWrapper::process(
 		rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/TimeUpdatingMaps/ms"), timeUpdateMaps*1000.0f));
 		rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/TimePublishing/ms"), timePublishMaps*1000.0f));
 		rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/TimeTotal/ms"), (timeRtabmap+timeUpdateMaps+timePublishMaps)*1000.0f));
+		if(isApproxSync() && getSyncSlack() > 0.0)
+		{
+			rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/SyncAddedLatency/ms"), getSyncAddedLatency()*1000.0f));
+		}
+		if(nodeDataCache_.capacity())
+		{
+			rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/NodeDataCacheSize/"), (float)nodeDataCache_.size()));
+			rtabmapROSStats_.insert(std::make_pair(std::string("RtabmapROS/NodeDataCacheHitRate/%"), nodeDataCache_.hitRate()*100.0f));
+		}
+
+		if(latencyTrace_)
+		{
+			// With map_update_async, maps stages are recorded by mapsUpdateThread()
+			rtabmap_ros::msg::LatencyTrace traceMsg;
+			traceMsg.header.stamp = stamp;
+			traceMsg.header.frame_id = mapFrameId_;
+			double start = timeStart.seconds();
+			// sync: sensor stamp -> synchronized callback
+			// tf: waiting for TF prefetch and odometry TF
+			// conversion: sensor messages -> SensorData
+			double inputTime = latencyInputTime_>0.0?latencyInputTime_:start;
+			double tfTime = latencyTFTime_>=inputTime?latencyTFTime_:inputTime;
+			latencyTracer_.record("sync", stamp.seconds(), stamp.seconds(), inputTime-stamp.seconds(), &traceMsg);
+			latencyTracer_.record("tf", stamp.seconds(), inputTime, tfTime-inputTime, &traceMsg);
+			latencyTracer_.record("conversion", stamp.seconds(), tfTime, start-tfTime, &traceMsg);
+			latencyTracer_.record("rtabmap", stamp.seconds(), start, timeRtabmap, &traceMsg);
+			start += timeRtabmap;
+			if(!mapsUpdateAsync_)
+			{
+				latencyTracer_.record("maps_update", stamp.seconds(), start, timeUpdateMaps, &traceMsg);
+				start += timeUpdateMaps;
+			}
+			latencyTracer_.record("publish", stamp.seconds(), start, timePublishMaps, &traceMsg);
+			if(latencyTracePub_->get_subscription_count())
+			{
+				latencyTracePub_->publish(traceMsg);
+			}
+		}
 	}
 	else if(!rtabmap_.isIDsGenerated())
 	{
@@ -2390,7 +2859,16 @@ void CoreWrapper::resetRtabmapCallback(
 		std::shared_ptr<std_srvs::srv::Empty::Response>)
 {
 	RCLCPP_INFO(this->get_logger(), "rtabmap: Reset");
+	mapsUpdateQueueMutex_.lock();
+	mapsUpdateQueue_.clear();
+	mapsUpdateQueueMutex_.unlock();
+	std::lock_guard<std::mutex> mapsLock(mapsMutex_);
+	std::lock_guard<std::mutex> memoryLock(memoryMutex_);
 	rtabmap_.resetMemory();
+	nodeDataCache_.clear();
+	mapDataDeltaEncoder_.reset();
+	mapGraphDeltaEncoder_.reset();
+	mapDataPageSessions_.clear();
 	covariance_ = cv::Mat();
 	lastPose_.setIdentity();
 	lastPoseIntermediate_ = false;
@@ -2450,6 +2928,7 @@ void CoreWrapper::triggerNewMapCallback(
 		std::shared_ptr<std_srvs::srv::Empty::Response>)
 {
 	RCLCPP_INFO(this->get_logger(), "rtabmap: Trigger new map");
+	std::lock_guard<std::mutex> memoryLock(memoryMutex_);
 	rtabmap_.triggerNewMap();
 }
 
@@ -2458,8 +2937,15 @@ void CoreWrapper::backupDatabaseCallback(
 		const std::shared_ptr<std_srvs::srv::Empty::Request>,
 		std::shared_ptr<std_srvs::srv::Empty::Response>)
 {
+	mapsUpdateQueueMutex_.lock();
+	mapsUpdateQueue_.clear();
+	mapsUpdateQueueMutex_.unlock();
+	std::lock_guard<std::mutex> mapsLock(mapsMutex_);
+	std::lock_guard<std::mutex> memoryLock(memoryMutex_);
+
 	RCLCPP_INFO(this->get_logger(), "Backup: Saving memory...");
 	rtabmap_.close();
+	nodeDataCache_.clear();
 	RCLCPP_INFO(this->get_logger(), "Backup: Saving memory... done!");
 
 	covariance_ = cv::Mat();
@@ -2493,6 +2979,7 @@ void CoreWrapper::setModeLocalizationCallback(
 	rtabmap::ParametersMap parameters;
 	parameters.insert(rtabmap::ParametersPair(rtabmap::Parameters::kMemIncrementalMemory(), "false"));
 	set_parameter(rclcpp::Parameter(rtabmap::Parameters::kMemIncrementalMemory(), "false"));
+	std::lock_guard<std::mutex> memoryLock(memoryMutex_);
 	rtabmap_.parseParameters(parameters);
 }
 
@@ -2505,6 +2992,7 @@ void CoreWrapper::setModeMappingCallback(
 	rtabmap::ParametersMap parameters;
 	parameters.insert(rtabmap::ParametersPair(rtabmap::Parameters::kMemIncrementalMemory(), "true"));
 	set_parameter(rclcpp::Parameter(rtabmap::Parameters::kMemIncrementalMemory(), "true"));
+	std::lock_guard<std::mutex> memoryLock(memoryMutex_);
 	rtabmap_.parseParameters(parameters);
 }
 
@@ -2578,10 +3066,229 @@ void CoreWrapper::getMapDataCallback(
 		constraints,
 		signatures,
 		mapToOdom_,
-		res->data);
+		res->data,
+		&nodeDataCache_);
+
+	res->data.header.stamp = now();
+	res->data.header.frame_id = mapFrameId_;
+
+	if(nodeDataCache_.capacity())
+	{
+		RCLCPP_INFO(this->get_logger(), "rtabmap: Node data cache: %d/%d nodes, hit rate=%.1f%%",
+				(int)nodeDataCache_.size(), (int)nodeDataCache_.capacity(), nodeDataCache_.hitRate()*100.0f);
+	}
+}
+
+void CoreWrapper::getMapDataPageCallback(
+		const std::shared_ptr<rmw_request_id_t>,
+		const std::shared_ptr<rtabmap_ros::srv::GetMapPage::Request> req,
+		std::shared_ptr<rtabmap_ros::srv::GetMapPage::Response> res)
+{
+	// Only a few downloads are expected at the same time
+	static const size_t maxSessions = 4;
 
 	res->data.header.stamp = now();
 	res->data.header.frame_id = mapFrameId_;
+
+	if(rtabmap_.getMemory() == 0)
+	{
+		res->success = false;
+		res->error = "Memory is not initialized";
+		RCLCPP_ERROR(this->get_logger(), "rtabmap: Cannot get map data page, memory is not initialized.");
+		return;
+	}
+
+	int sessionId = 0;
+	int offset = 0;
+	if(req->continuation_token.empty())
+	{
+		// Snapshot of the graph, the graph is not optimized again here
+		std::map<int, Transform> poses;
+		std::multimap<int, rtabmap::Link> constraints;
+		memoryMutex_.lock();
+		if(req->optimized)
+		{
+			poses = rtabmap_.getLocalOptimizedPoses();
+			constraints = rtabmap_.getLocalConstraints();
+		}
+		else
+		{
+			rtabmap_.getGraph(
+					poses,
+					constraints,
+					false,
+					req->global);
+		}
+		memoryMutex_.unlock();
+
+		bool useBbox = req->bbox_min.x != req->bbox_max.x ||
+				req->bbox_min.y != req->bbox_max.y ||
+				req->bbox_min.z != req->bbox_max.z;
+		std::map<int, Transform> selectedPoses;
+		for(std::map<int, Transform>::iterator iter=poses.begin(); iter!=poses.end(); ++iter)
+		{
+			if((req->min_id > 0 && iter->first < req->min_id) ||
+			   (req->max_id > 0 && iter->first > req->max_id))
+			{
+				continue;
+			}
+			if(useBbox &&
+			   (iter->second.x() < req->bbox_min.x || iter->second.x() > req->bbox_max.x ||
+				iter->second.y() < req->bbox_min.y || iter->second.y() > req->bbox_max.y ||
+				iter->second.z() < req->bbox_min.z || iter->second.z() > req->bbox_max.z))
+			{
+				continue;
+			}
+			selectedPoses.insert(*iter);
+		}
+		std::multimap<int, rtabmap::Link> selectedConstraints;
+		for(std::multimap<int, rtabmap::Link>::iterator iter=constraints.begin(); iter!=constraints.end(); ++iter)
+		{
+			if(selectedPoses.find(iter->second.from()) != selectedPoses.end() &&
+			   selectedPoses.find(iter->second.to()) != selectedPoses.end())
+			{
+				selectedConstraints.insert(*iter);
+			}
+		}
+
+		sessionId = ++mapDataPageSessionId_;
+		MapDataPageSession & session = mapDataPageSessions_[sessionId];
+		for(std::map<int, Transform>::iterator iter=selectedPoses.lower_bound(1); iter!=selectedPoses.end(); ++iter)
+		{
+			// landmarks (negative ids) have no node data
+			session.ids.push_back(iter->first);
+		}
+		while(mapDataPageSessions_.size() > maxSessions)
+		{
+			RCLCPP_WARN(this->get_logger(), "rtabmap: Too many paginated map downloads, session %d is discarded.",
+					mapDataPageSessions_.begin()->first);
+			mapDataPageSessions_.erase(mapDataPageSessions_.begin());
+		}
+
+		// The graph is only sent with the first page
+		rtabmap_ros::mapGraphToROS(selectedPoses,
+			selectedConstraints,
+			mapToOdom_,
+			res->data.graph);
+
+		RCLCPP_INFO(this->get_logger(), "rtabmap: Getting map by pages (session=%d global=%s optimized=%s): %d/%d nodes selected",
+				sessionId,
+				req->global?"true":"false",
+				req->optimized?"true":"false",
+				(int)session.ids.size(),
+				(int)poses.size());
+	}
+	else
+	{
+		std::list<std::string> token = uSplit(req->continuation_token, ':');
+		if(token.size() != 2 || !uIsInteger(token.front()) || !uIsInteger(token.back()))
+		{
+			res->success = false;
+			res->error = uFormat("Invalid continuation token \"%s\"", req->continuation_token.c_str());
+			RCLCPP_ERROR(this->get_logger(), "rtabmap: %s.", res->error.c_str());
+			return;
+		}
+		sessionId = uStr2Int(token.front());
+		offset = uStr2Int(token.back());
+	}
+
+	std::map<int, MapDataPageSession>::iterator sessionIter = mapDataPageSessions_.find(sessionId);
+	if(sessionIter == mapDataPageSessions_.end() || offset < 0 || offset > (int)sessionIter->second.ids.size())
+	{
+		res->success = false;
+		res->error = uFormat("Continuation token \"%s\" is expired, "
+				"restart the download with an empty token", req->continuation_token.c_str());
+		RCLCPP_ERROR(this->get_logger(), "rtabmap: %s.", res->error.c_str());
+		return;
+	}
+	const MapDataPageSession & session = sessionIter->second;
+
+	int maxNodes = req->max_nodes>0?req->max_nodes:mapDataPageSize_;
+	size_t pageBytes = 0;
+	int end = offset;
+	std::vector<Signature> signatures;
+	while(end < (int)session.ids.size() && (maxNodes <= 0 || end-offset < maxNodes))
+	{
+		int id = session.ids[end];
+		Transform odomPose, groundTruth;
+		int mapId = -1;
+		int weight = -1;
+		std::string label;
+		double stamp = 0.0;
+		std::vector<float> velocity;
+		GPS gps;
+		EnvSensors sensors;
+		std::multimap<int, int> words;
+		std::vector<cv::KeyPoint> wordsKpts;
+		std::vector<cv::Point3f> words3;
+		cv::Mat wordsDescriptors;
+		SensorData data;
+		// one node at a time, so that the SLAM thread is not blocked for the whole page
+		memoryMutex_.lock();
+		bool found = rtabmap_.getMemory()->getNodeInfo(id, odomPose, mapId, weight, label, stamp, groundTruth, velocity, gps, sensors, true);
+		if(found)
+		{
+			data = rtabmap_.getMemory()->getNodeData(id, true, true, true, true);
+			rtabmap_.getMemory()->getNodeWords(id, words, wordsKpts, words3, wordsDescriptors);
+		}
+		memoryMutex_.unlock();
+		if(!found)
+		{
+			// node removed since the first page
+			RCLCPP_WARN(this->get_logger(), "rtabmap: Node %d of map data page session %d is not in memory anymore, it is skipped.", id, sessionId);
+			++end;
+			continue;
+		}
+		Signature s(id, mapId, weight, stamp, label, odomPose, groundTruth, data);
+		s.setWords(words, wordsKpts, words3, wordsDescriptors);
+		if(velocity.size() == 6)
+		{
+			s.setVelocity(velocity[0], velocity[1], velocity[2], velocity[3], velocity[4], velocity[5]);
+		}
+		s.sensorData().setGPS(gps);
+		s.sensorData().setEnvSensors(sensors);
+		size_t nodeBytes =
+				s.sensorData().imageCompressed().total() +
+				s.sensorData().depthOrRightCompressed().total() +
+				s.sensorData().laserScanCompressed().data().total() +
+				s.sensorData().userDataCompressed().total() +
+				s.sensorData().gridGroundCellsCompressed().total() +
+				s.sensorData().gridObstacleCellsCompressed().total() +
+				s.sensorData().gridEmptyCellsCompressed().total() +
+				// visual words are compressed only when serialized, use their raw size
+				s.getWordsDescriptors().total()*s.getWordsDescriptors().elemSize() +
+				s.getWordsKpts().size()*sizeof(cv::KeyPoint) +
+				s.getWords3().size()*sizeof(cv::Point3f) +
+				s.getWords().size()*sizeof(int);
+		if(req->max_bytes > 0 && end > offset && pageBytes + nodeBytes > (size_t)req->max_bytes)
+		{
+			break;
+		}
+		pageBytes += nodeBytes;
+		signatures.push_back(s);
+		++end;
+	}
+
+	res->data.nodes.resize(signatures.size());
+	for(size_t i=0; i<signatures.size(); ++i)
+	{
+		nodeDataCache_.toROS(signatures[i], res->data.nodes[i]);
+	}
+
+	res->success = true;
+	res->total_nodes = session.ids.size();
+	res->sent_nodes = end;
+	if(end < (int)session.ids.size())
+	{
+		res->next_token = uFormat("%d:%d", sessionId, end);
+	}
+	else
+	{
+		// The session is kept until discarded by newer ones, so that the
+		// last page can be requested again if the response was lost.
+		RCLCPP_INFO(this->get_logger(), "rtabmap: Getting map by pages (session=%d): done, %d nodes sent",
+				sessionId, (int)session.ids.size());
+	}
 }
 
 void CoreWrapper::getMapCallback(
@@ -2591,7 +3298,9 @@ void CoreWrapper::getMapCallback(
 {
 	// create the grid map
 	float xMin=0.0f, yMin=0.0f, gridCellSize = 0.05f;
+	mapsMutex_.lock();
 	cv::Mat pixels = mapsManager_.getGridMap(xMin, yMin, gridCellSize);
+	mapsMutex_.unlock();
 
 	if(!pixels.empty())
 	{
@@ -2625,7 +3334,9 @@ void CoreWrapper::getProbMapCallback(
 {
 	// create the grid map
 	float xMin=0.0f, yMin=0.0f, gridCellSize = 0.05f;
+	mapsMutex_.lock();
 	cv::Mat pixels = mapsManager_.getGridProbMap(xMin, yMin, gridCellSize);
+	mapsMutex_.unlock();
 
 	if(!pixels.empty())
 	{
@@ -2697,7 +3408,8 @@ void CoreWrapper::publishMapCallback(
 				constraints,
 				signatures,
 				mapToOdom_,
-				*msg);
+				*msg,
+				&nodeDataCache_);
 
 			mapDataPub_->publish(std::move(msg));
 		}
@@ -2766,6 +3478,7 @@ void CoreWrapper::publishMapCallback(
 
 		if(!req->graph_only && mapsManager_.hasSubscribers())
 		{
+			std::lock_guard<std::mutex> mapsLock(mapsMutex_);
 			std::map<int, Transform> filteredPoses(poses.lower_bound(1), poses.end());
 			if(maxMappingNodes_ > 0 && filteredPoses.size()>1)
 			{
@@ -3165,15 +3878,48 @@ void CoreWrapper::publishStats(const rclcpp::Time & stamp)
 	UDEBUG("Publishing stats...");
 	const rtabmap::Statistics & stats = rtabmap_.getStatistics();
 
+	// Messages of the statistics groups are only built if subscribed, all
+	// in one pass over the statistics
+	rtabmap_ros::msg::Info::UniquePtr infoMsg;
+	rtabmap_ros::msg::Info::UniquePtr infoTimingsMsg;
+	rtabmap_ros::msg::Info::UniquePtr infoLoopClosureMsg;
+	std::vector<std::pair<rtabmap_ros::msg::Info*, int> > infoMsgs;
 	if(infoPub_->get_subscription_count())
 	{
 		//RCLCPP_INFO(this->get_logger(), "Sending RtabmapInfo msg (last_id=%d)...", stat.refImageId());
-		rtabmap_ros::msg::Info::UniquePtr msg(new rtabmap_ros::msg::Info);
-		msg->header.stamp = stamp;
-		msg->header.frame_id = mapFrameId_;
-
-		rtabmap_ros::infoToROS(stats, *msg);
-		infoPub_->publish(std::move(msg));
+		infoMsg.reset(new rtabmap_ros::msg::Info);
+		infoMsgs.push_back(std::make_pair(infoMsg.get(), infoGroups_));
+	}
+	if(infoTimingsPub_->get_subscription_count())
+	{
+		infoTimingsMsg.reset(new rtabmap_ros::msg::Info);
+		infoMsgs.push_back(std::make_pair(infoTimingsMsg.get(), (int)kInfoTimings));
+	}
+	if(infoLoopClosurePub_->get_subscription_count())
+	{
+		infoLoopClosureMsg.reset(new rtabmap_ros::msg::Info);
+		infoMsgs.push_back(std::make_pair(infoLoopClosureMsg.get(), (int)kInfoLoopClosure));
+	}
+	if(!infoMsgs.empty())
+	{
+		for(size_t i=0; i<infoMsgs.size(); ++i)
+		{
+			infoMsgs[i].first->header.stamp = stamp;
+			infoMsgs[i].first->header.frame_id = mapFrameId_;
+		}
+		rtabmap_ros::infoToROS(stats, infoMsgs);
+		if(infoMsg)
+		{
+			infoPub_->publish(std::move(infoMsg));
+		}
+		if(infoTimingsMsg)
+		{
+			infoTimingsPub_->publish(std::move(infoTimingsMsg));
+		}
+		if(infoLoopClosureMsg)
+		{
+			infoLoopClosurePub_->publish(std::move(infoLoopClosureMsg));
+		}
 	}
 
 	if(mapDataPub_->get_subscription_count())
@@ -3187,15 +3933,36 @@ void CoreWrapper::publishStats(const rclcpp::Time & stamp)
 		{
 			signatures.insert(std::make_pair(stats.getLastSignatureData().id(), stats.getLastSignatureData()));
 		}
-		rtabmap_ros::mapDataToROS(
-			stats.poses(),
-			stats.constraints(),
-			signatures,
-			stats.mapCorrection(),
-			*msg);
+		if(mapDataDeltaEncoder_.keyframeInterval() > 0)
+		{
+			// new subscribers need a full graph
+			if(mapDataPub_->get_subscription_count() > mapDataSubscriptions_)
+			{
+				mapDataDeltaEncoder_.reset();
+			}
+			rtabmap_ros::mapDataToROS(
+				std::map<int, Transform>(),
+				std::multimap<int, rtabmap::Link>(),
+				signatures,
+				stats.mapCorrection(),
+				*msg,
+				&nodeDataCache_);
+			mapDataDeltaEncoder_.encode(stats.poses(), stats.constraints(), stats.mapCorrection(), msg->graph);
+		}
+		else
+		{
+			rtabmap_ros::mapDataToROS(
+				stats.poses(),
+				stats.constraints(),
+				signatures,
+				stats.mapCorrection(),
+				*msg,
+				&nodeDataCache_);
+		}
 
 		mapDataPub_->publish(std::move(msg));
 	}
+	mapDataSubscriptions_ = mapDataPub_->get_subscription_count();
 
 	if(mapGraphPub_->get_subscription_count())
 	{
@@ -3203,14 +3970,27 @@ void CoreWrapper::publishStats(const rclcpp::Time & stamp)
 		msg->header.stamp = stamp;
 		msg->header.frame_id = mapFrameId_;
 
-		rtabmap_ros::mapGraphToROS(
-			stats.poses(),
-			stats.constraints(),
-			stats.mapCorrection(),
-			*msg);
+		if(mapGraphDeltaEncoder_.keyframeInterval() > 0)
+		{
+			// new subscribers need a full graph
+			if(mapGraphPub_->get_subscription_count() > mapGraphSubscriptions_)
+			{
+				mapGraphDeltaEncoder_.reset();
+			}
+			mapGraphDeltaEncoder_.encode(stats.poses(), stats.constraints(), stats.mapCorrection(), *msg);
+		}
+		else
+		{
+			rtabmap_ros::mapGraphToROS(
+				stats.poses(),
+				stats.constraints(),
+				stats.mapCorrection(),
+				*msg);
+		}
 
 		mapGraphPub_->publish(std::move(msg));
 	}
+	mapGraphSubscriptions_ = mapGraphPub_->get_subscription_count();
 
 	if(localGridObstacle_->get_subscription_count() && !stats.getLastSignatureData().sensorData().gridObstacleCellsRaw().empty())
 	{
@@ -3597,6 +4377,54 @@ void CoreWrapper::publishGlobalPath(const rclcpp::Time & stamp)
 	}
 }
 
+void CoreWrapper::mapsUpdateThread()
+{
+	while(true)
+	{
+		MapsUpdateRequest request;
+		{
+			std::unique_lock<std::mutex> lock(mapsUpdateQueueMutex_);
+			mapsUpdateQueueCondition_.wait(lock, [this](){return !mapsUpdateThreadRunning_ || !mapsUpdateQueue_.empty();});
+			if(!mapsUpdateThreadRunning_)
+			{
+				break;
+			}
+			request = mapsUpdateQueue_.front();
+			mapsUpdateQueue_.pop_front();
+		}
+
+		UTimer timer;
+		double timeStart = now().seconds();
+		mapsMutex_.lock();
+		// Memory is only locked while loading data of nodes not already in the map caches
+		std::map<int, Transform> filteredPoses = mapsManager_.updateMapCaches(
+				request.poses,
+				rtabmap_.getMemory(),
+				false,
+				false,
+				request.signatures,
+				&memoryMutex_);
+		double timeUpdateMaps = timer.ticks();
+		mapsManager_.publishMaps(filteredPoses, request.stamp, request.mapFrameId);
+		double timePublishMaps = timer.ticks();
+		mapsMutex_.unlock();
+
+		UDEBUG("Maps update=%.4fs pub=%.4fs (poses=%d)", timeUpdateMaps, timePublishMaps, (int)request.poses.size());
+
+		if(latencyTrace_)
+		{
+			latencyTracer_.record("maps_update", request.stamp.seconds(), timeStart, timeUpdateMaps);
+			latencyTracer_.record("maps_publish", request.stamp.seconds(), timeStart+timeUpdateMaps, timePublishMaps);
+		}
+
+		mapsUpdateQueueMutex_.lock();
+		mapsUpdateLastTimeUpdate_ = timeUpdateMaps;
+		mapsUpdateLastTimePublish_ = timePublishMaps;
+		mapsUpdateLastId_ = request.id;
+		mapsUpdateQueueMutex_.unlock();
+	}
+}
+
 #ifdef WITH_OCTOMAP_MSGS
 #ifdef RTABMAP_OCTOMAP
 bool CoreWrapper::octomapBinaryCallback(
@@ -3623,6 +4451,7 @@ bool CoreWrapper::octomapBinaryCallback(
 		poses = nearestPoses;
 	}
 
+	std::lock_guard<std::mutex> mapsLock(mapsMutex_);
 	poses = mapsManager_.updateMapCaches(poses, rtabmap_.getMemory(), false, true);
 
 	const rtabmap::OctoMap * octomap = mapsManager_.getOctomap();
@@ -3654,6 +4483,7 @@ bool CoreWrapper::octomapFullCallback(
 		poses = nearestPoses;
 	}
 
+	std::lock_guard<std::mutex> mapsLock(mapsMutex_);
 	poses = mapsManager_.updateMapCaches(poses, rtabmap_.getMemory(), false, true);
 
 	const rtabmap::OctoMap * octomap = mapsManager_.getOctomap();
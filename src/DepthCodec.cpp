@@ -0,0 +1,307 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "rtabmap_ros/DepthCodec.h"
+
+#include <rtabmap/core/Compression.h>
+#include <rtabmap/utilite/ULogger.h>
+
+#include <cstring>
+
+namespace rtabmap_ros {
+
+namespace {
+
+// Header: rows and cols as int32, followed by 32 bits words of nibbles
+static const size_t kHeaderSize = 2*sizeof(int);
+
+class NibbleWriter
+{
+public:
+	NibbleWriter(std::vector<unsigned char> & output) :
+		output_(output),
+		word_(0),
+		nibbles_(0)
+	{}
+
+	// 3 bits of data per nibble, the 4th bit tells if more nibbles follow
+	void encode(unsigned int value)
+	{
+		do
+		{
+			unsigned int nibble = value & 0x7;
+			value >>= 3;
+			if(value)
+			{
+				nibble |= 0x8;
+			}
+			word_ = (word_ << 4) | nibble;
+			if(++nibbles_ == 8)
+			{
+				flushWord();
+			}
+		}
+		while(value);
+	}
+
+	void flush()
+	{
+		if(nibbles_)
+		{
+			word_ <<= 4 * (8 - nibbles_);
+			flushWord();
+		}
+	}
+
+private:
+	void flushWord()
+	{
+		size_t size = output_.size();
+		output_.resize(size + sizeof(word_));
+		memcpy(output_.data() + size, &word_, sizeof(word_));
+		word_ = 0;
+		nibbles_ = 0;
+	}
+
+private:
+	std::vector<unsigned char> & output_;
+	unsigned int word_;
+	int nibbles_;
+};
+
+class NibbleReader
+{
+public:
+	NibbleReader(const unsigned char * data, size_t size) :
+		data_(data),
+		end_(data + size),
+		word_(0),
+		nibbles_(0)
+	{}
+
+	bool decode(unsigned int & value)
+	{
+		value = 0;
+		int shift = 0;
+		unsigned int nibble;
+		do
+		{
+			if(shift > 30)
+			{
+				return false;
+			}
+			if(nibbles_ == 0)
+			{
+				if(data_ + sizeof(word_) > end_)
+				{
+					return false;
+				}
+				memcpy(&word_, data_, sizeof(word_));
+				data_ += sizeof(word_);
+				nibbles_ = 8;
+			}
+			nibble = word_ >> 28;
+			value |= (nibble & 0x7) << shift;
+			shift += 3;
+			word_ <<= 4;
+			--nibbles_;
+		}
+		while(nibble & 0x8);
+		return true;
+	}
+
+private:
+	const unsigned char * data_;
+	const unsigned char * end_;
+	unsigned int word_;
+	int nibbles_;
+};
+
+}
+
+bool isDepthFormatRVL(const std::string & format)
+{
+	return format.compare(kDepthFormatRVL) == 0 || format.compare(kDepthFormatRVLZlib) == 0;
+}
+
+std::vector<unsigned char> compressDepthRVL(const cv::Mat & depth, bool zlib)
+{
+	std::vector<unsigned char> bytes;
+	if(depth.empty() || depth.type() != CV_16UC1)
+	{
+		UERROR("RVL compression requires a CV_16UC1 depth image (type=%d)", depth.type());
+		return bytes;
+	}
+
+	// worst case is about 3 nibbles per pixel, most images are far below
+	bytes.reserve(kHeaderSize + depth.total());
+	bytes.resize(kHeaderSize);
+	int header[2] = {depth.rows, depth.cols};
+	memcpy(bytes.data(), header, kHeaderSize);
+
+	NibbleWriter writer(bytes);
+	unsigned short previous = 0;
+	for(int y=0; y<depth.rows; ++y)
+	{
+		const unsigned short * ptr = depth.ptr<unsigned short>(y);
+		const unsigned short * end = ptr + depth.cols;
+		while(ptr != end)
+		{
+			unsigned int zeros = 0;
+			for(; ptr != end && *ptr == 0; ++ptr, ++zeros);
+			writer.encode(zeros);
+
+			unsigned int nonZeros = 0;
+			for(const unsigned short * p = ptr; p != end && *p != 0; ++p, ++nonZeros);
+			writer.encode(nonZeros);
+
+			for(unsigned int i=0; i<nonZeros; ++i, ++ptr)
+			{
+				int delta = int(*ptr) - int(previous);
+				// zigzag, small negative and positive deltas give small values
+				writer.encode((unsigned int)((delta << 1) ^ (delta >> 31)));
+				previous = *ptr;
+			}
+		}
+	}
+	writer.flush();
+
+	if(zlib)
+	{
+		return rtabmap::compressData(cv::Mat(1, bytes.size(), CV_8UC1, bytes.data()));
+	}
+	return bytes;
+}
+
+cv::Mat uncompressDepthRVL(const std::vector<unsigned char> & bytes, bool zlib, cv::Mat * buffer)
+{
+	cv::Mat inflated;
+	const unsigned char * data = bytes.data();
+	size_t size = bytes.size();
+	if(zlib)
+	{
+		inflated = rtabmap::uncompressData(bytes);
+		data = inflated.data;
+		size = inflated.total() * inflated.elemSize();
+	}
+
+	if(size < kHeaderSize)
+	{
+		UERROR("RVL data too small (%d bytes)", (int)size);
+		return cv::Mat();
+	}
+	int header[2];
+	memcpy(header, data, kHeaderSize);
+	if(header[0] <= 0 || header[1] <= 0)
+	{
+		UERROR("Invalid RVL image size (%dx%d)", header[1], header[0]);
+		return cv::Mat();
+	}
+
+	cv::Mat depth;
+	if(buffer)
+	{
+		buffer->create(header[0], header[1], CV_16UC1);
+		depth = *buffer;
+	}
+	else
+	{
+		depth = cv::Mat(header[0], header[1], CV_16UC1);
+	}
+
+	NibbleReader reader(data + kHeaderSize, size - kHeaderSize);
+	unsigned short previous = 0;
+	for(int y=0; y<depth.rows; ++y)
+	{
+		unsigned short * ptr = depth.ptr<unsigned short>(y);
+		unsigned int remaining = depth.cols;
+		while(remaining)
+		{
+			unsigned int zeros, nonZeros;
+			if(!reader.decode(zeros) || zeros > remaining)
+			{
+				UERROR("Corrupted RVL data");
+				return cv::Mat();
+			}
+			memset(ptr, 0, zeros*sizeof(unsigned short));
+			ptr += zeros;
+			remaining -= zeros;
+
+			if(!reader.decode(nonZeros) || nonZeros > remaining)
+			{
+				UERROR("Corrupted RVL data");
+				return cv::Mat();
+			}
+			remaining -= nonZeros;
+			for(; nonZeros; --nonZeros)
+			{
+				unsigned int value;
+				if(!reader.decode(value))
+				{
+					UERROR("Corrupted RVL data");
+					return cv::Mat();
+				}
+				int delta = int(value >> 1) ^ -int(value & 1);
+				previous = (unsigned short)(int(previous) + delta);
+				*ptr++ = previous;
+			}
+		}
+	}
+	return depth;
+}
+
+std::vector<unsigned char> compressDepth(const cv::Mat & depth, const std::string & format, std::string & outputFormat)
+{
+	if(isDepthFormatRVL(format))
+	{
+		if(depth.type() == CV_16UC1)
+		{
+			outputFormat = format;
+			return compressDepthRVL(depth, format.compare(kDepthFormatRVLZlib) == 0);
+		}
+		static bool shown = false;
+		if(!shown)
+		{
+			UWARN("Depth format \"%s\" requires 16 bits depth images, using png "
+					"instead. This warning is printed only once.", format.c_str());
+			shown = true;
+		}
+	}
+	else if(format.compare("png") != 0)
+	{
+		static bool shown = false;
+		if(!shown)
+		{
+			UWARN("Unknown depth format \"%s\", using png instead. This "
+					"warning is printed only once.", format.c_str());
+			shown = true;
+		}
+	}
+	outputFormat = "png";
+	return rtabmap::compressImage(depth, ".png");
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "rtabmap_ros/DepthCodec.h"
+#include <rtabmap/core/Compression.h>
+#include <rtabmap/utilite/UTimer.h>
+#include <opencv2/imgcodecs.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void showUsage()
+{
+	printf("\nUsage:\n"
+			"depth_codec_benchmark [options] depth1.png depth2.png ...\n"
+			"  Compare encoding/decoding time and compression ratio of the\n"
+			"  depth_compressed formats on 16 bits depth images.\n"
+			"Options:\n"
+			"  -i #    Iterations per image (default 20).\n");
+	exit(1);
+}
+
+int main(int argc, char **argv)
+{
+	int iterations = 20;
+	std::vector<std::string> files;
+	for(int i=1; i<argc; ++i)
+	{
+		if(strcmp(argv[i], "-i") == 0 && i+1<argc)
+		{
+			iterations = atoi(argv[++i]);
+			if(iterations <= 0)
+			{
+				showUsage();
+			}
+		}
+		else if(argv[i][0] == '-')
+		{
+			showUsage();
+		}
+		else
+		{
+			files.push_back(argv[i]);
+		}
+	}
+	if(files.empty())
+	{
+		showUsage();
+	}
+
+	const std::string formats[] = {"png", rtabmap_ros::kDepthFormatRVL, rtabmap_ros::kDepthFormatRVLZlib};
+	const int formatsCount = 3;
+	double encodeTime[formatsCount] = {0};
+	double decodeTime[formatsCount] = {0};
+	double compressedSize[formatsCount] = {0};
+	double rawSize = 0;
+	int images = 0;
+
+	for(size_t i=0; i<files.size(); ++i)
+	{
+		cv::Mat depth = cv::imread(files[i], cv::IMREAD_UNCHANGED);
+		if(depth.type() != CV_16UC1)
+		{
+			printf("Skipping \"%s\", not a 16 bits depth image.\n", files[i].c_str());
+			continue;
+		}
+		rawSize += depth.total() * depth.elemSize();
+		++images;
+
+		for(int f=0; f<formatsCount; ++f)
+		{
+			std::vector<unsigned char> bytes;
+			std::string outputFormat;
+			UTimer timer;
+			for(int n=0; n<iterations; ++n)
+			{
+				bytes = rtabmap_ros::compressDepth(depth, formats[f], outputFormat);
+			}
+			encodeTime[f] += timer.ticks()/double(iterations);
+			compressedSize[f] += bytes.size();
+
+			cv::Mat decoded;
+			for(int n=0; n<iterations; ++n)
+			{
+				if(rtabmap_ros::isDepthFormatRVL(outputFormat))
+				{
+					decoded = rtabmap_ros::uncompressDepthRVL(bytes, outputFormat.compare(rtabmap_ros::kDepthFormatRVLZlib) == 0);
+				}
+				else
+				{
+					decoded = rtabmap::uncompressImage(bytes);
+				}
+			}
+			decodeTime[f] += timer.ticks()/double(iterations);
+
+			if(decoded.type() != depth.type() || cv::countNonZero(decoded != depth) != 0)
+			{
+				printf("Error: \"%s\" is not lossless on \"%s\"!\n", formats[f].c_str(), files[i].c_str());
+			}
+		}
+	}
+
+	if(images == 0)
+	{
+		return 1;
+	}
+
+	printf("%d images, %d iterations\n", images, iterations);
+	printf("%-10s %12s %12s %8s\n", "format", "encode (ms)", "decode (ms)", "ratio");
+	for(int f=0; f<formatsCount; ++f)
+	{
+		printf("%-10s %12.3f %12.3f %8.2f\n",
+				formats[f].c_str(),
+				encodeTime[f]*1000.0/images,
+				decodeTime[f]*1000.0/images,
+				rawSize/compressedSize[f]);
+	}
+	return 0;
+}
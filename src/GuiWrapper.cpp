@@ -181,7 +181,17 @@ void GuiWrapper::infoMapCallback(
 	std::map<int, Signature> signatures;
 	std::multimap<int, rtabmap::Link> links;
 
-	rtabmap_ros::mapDataFromROS(*mapMsg, poses, links, signatures, mapToOdom);
+	// the graph may be delta encoded (see map_delta_keyframe_interval of rtabmap node)
+	if(!mapGraphDecoder_.decode(mapMsg->graph, poses, links, mapToOdom))
+	{
+		RCLCPP_WARN(this->get_logger(), "rtabmapviz: a delta encoded map graph message has been missed, "
+				"waiting for the next full graph before updating the view...");
+		return;
+	}
+	for(unsigned int i=0; i<mapMsg->nodes.size(); ++i)
+	{
+		signatures.insert(std::make_pair(mapMsg->nodes[i].id, rtabmap_ros::nodeDataFromROS(mapMsg->nodes[i])));
+	}
 
 	stat.setMapCorrection(mapToOdom);
 	stat.setPoses(poses);
@@ -0,0 +1,203 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "rtabmap_ros/LaserScanConverter.h"
+
+#include <rtabmap/utilite/ULogger.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace rtabmap_ros {
+
+LaserScanConverter::LaserScanConverter() :
+		angleMin_(0.0f),
+		angleIncrement_(0.0f)
+{
+}
+
+void LaserScanConverter::updateTables(const sensor_msgs::msg::LaserScan & msg)
+{
+	if(cos_.size() != msg.ranges.size() ||
+	   angleMin_ != msg.angle_min ||
+	   angleIncrement_ != msg.angle_increment)
+	{
+		UDEBUG("Scan geometry changed (beams=%d, angle_min=%f, angle_increment=%f), updating tables.",
+				(int)msg.ranges.size(), msg.angle_min, msg.angle_increment);
+		angleMin_ = msg.angle_min;
+		angleIncrement_ = msg.angle_increment;
+		cos_.resize(msg.ranges.size());
+		sin_.resize(msg.ranges.size());
+		for(size_t i=0; i<msg.ranges.size(); ++i)
+		{
+			double angle = msg.angle_min + (double)i * msg.angle_increment;
+			cos_[i] = std::cos(angle);
+			sin_[i] = std::sin(angle);
+		}
+	}
+}
+
+cv::Mat LaserScanConverter::convert(
+		const sensor_msgs::msg::LaserScan & msg,
+		int downsamplingStep,
+		float rangeMin,
+		float rangeMax,
+		int normalK,
+		float normalRadius)
+{
+	updateTables(msg);
+
+	bool normals = normalK > 0 || normalRadius > 0.0f;
+	int type = normals?CV_32FC(5):CV_32FC2;
+	int maxPoints = (int)msg.ranges.size();
+
+	// Reuse the buffer only if the previous scan returned is not referenced anymore
+	if(buffer_.empty() || buffer_.type() != type || buffer_.cols < maxPoints || !buffer_.u || CV_XADD(&buffer_.u->refcount, 0) > 1)
+	{
+		buffer_ = cv::Mat(1, maxPoints, type);
+	}
+
+	float minRange = rangeMin > msg.range_min?rangeMin:msg.range_min;
+	float maxRange = rangeMax > 0.0f && rangeMax < msg.range_max?rangeMax:msg.range_max;
+	int step = downsamplingStep>1?downsamplingStep:1;
+	int n = 0;
+	float * ptr = buffer_.ptr<float>();
+	int channels = buffer_.channels();
+	for(size_t i=0; i<msg.ranges.size(); i+=step)
+	{
+		float r = msg.ranges[i];
+		if(std::isfinite(r) && r >= minRange && r <= maxRange)
+		{
+			float * pt = ptr + n*channels;
+			pt[0] = r * cos_[i];
+			pt[1] = r * sin_[i];
+			++n;
+		}
+	}
+
+	if(n == 0)
+	{
+		return cv::Mat();
+	}
+
+	cv::Mat scan = buffer_.colRange(0, n);
+	if(normals)
+	{
+		n = computeNormals(scan, normalK, normalRadius);
+		if(n == 0)
+		{
+			return cv::Mat();
+		}
+		scan = buffer_.colRange(0, n);
+	}
+	return scan;
+}
+
+int LaserScanConverter::computeNormals(cv::Mat & scan, int normalK, float normalRadius) const
+{
+	// Beams are organized, so neighbors are the points around in the scan
+	int halfWindow = normalK>0?(normalK+1)/2:5;
+	float radiusSqr = normalRadius * normalRadius;
+	float * ptr = scan.ptr<float>();
+	const float bad = std::numeric_limits<float>::quiet_NaN();
+	for(int i=0; i<scan.cols; ++i)
+	{
+		float * pt = ptr + i*5;
+		float mx=0.0f, my=0.0f;
+		int count = 0;
+		int start = i-halfWindow>0?i-halfWindow:0;
+		int end = i+halfWindow<scan.cols-1?i+halfWindow:scan.cols-1;
+		for(int j=start; j<=end; ++j)
+		{
+			const float * ptj = ptr + j*5;
+			if(normalRadius > 0.0f &&
+			   (ptj[0]-pt[0])*(ptj[0]-pt[0]) + (ptj[1]-pt[1])*(ptj[1]-pt[1]) > radiusSqr)
+			{
+				continue;
+			}
+			mx += ptj[0];
+			my += ptj[1];
+			++count;
+		}
+		if(count < 2)
+		{
+			pt[2] = pt[3] = pt[4] = bad;
+			continue;
+		}
+		mx /= float(count);
+		my /= float(count);
+		float cxx=0.0f, cxy=0.0f, cyy=0.0f;
+		for(int j=start; j<=end; ++j)
+		{
+			const float * ptj = ptr + j*5;
+			if(normalRadius > 0.0f &&
+			   (ptj[0]-pt[0])*(ptj[0]-pt[0]) + (ptj[1]-pt[1])*(ptj[1]-pt[1]) > radiusSqr)
+			{
+				continue;
+			}
+			float dx = ptj[0]-mx;
+			float dy = ptj[1]-my;
+			cxx += dx*dx;
+			cxy += dx*dy;
+			cyy += dy*dy;
+		}
+		// normal is perpendicular to the principal direction, oriented toward the sensor
+		float theta = 0.5f*std::atan2(2.0f*cxy, cxx-cyy);
+		float nx = -std::sin(theta);
+		float ny = std::cos(theta);
+		if(nx*pt[0] + ny*pt[1] > 0.0f)
+		{
+			nx = -nx;
+			ny = -ny;
+		}
+		pt[2] = nx;
+		pt[3] = ny;
+		pt[4] = 0.0f;
+	}
+
+	// Remove points without valid normal (not enough neighbors), done after
+	// all normals are computed as neighbors are looked up in the organized scan
+	int n = 0;
+	for(int i=0; i<scan.cols; ++i)
+	{
+		float * pt = ptr + i*5;
+		if(std::isfinite(pt[2]))
+		{
+			if(n != i)
+			{
+				memcpy(ptr + n*5, pt, 5*sizeof(float));
+			}
+			++n;
+		}
+	}
+	if(n < scan.cols)
+	{
+		UDEBUG("Removed %d/%d points without valid normal.", scan.cols-n, scan.cols);
+	}
+	return n;
+}
+
+} /* namespace rtabmap_ros */
@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "rtabmap_ros/LatencyTracer.h"
+
+#include <rtabmap/utilite/ULogger.h>
+#include <rtabmap/utilite/UConversion.h>
+#include <rtabmap/utilite/UFile.h>
+#include <fstream>
+#include <iomanip>
+
+namespace rtabmap_ros {
+
+LatencyTracer::LatencyTracer(unsigned int capacity) :
+		head_(0)
+{
+	setCapacity(capacity);
+}
+
+void LatencyTracer::setCapacity(unsigned int capacity)
+{
+	UASSERT(capacity > 0);
+	slots_ = std::vector<Slot>(capacity);
+	head_ = 0;
+}
+
+void LatencyTracer::record(
+		const char * stage,
+		double stamp,
+		double start,
+		double duration,
+		rtabmap_ros::msg::LatencyTrace * msg)
+{
+	unsigned long long index = head_.fetch_add(1, std::memory_order_relaxed);
+	Slot & slot = slots_[index % slots_.size()];
+	slot.sequence.store(2*index+1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.event.stage = stage;
+	slot.event.stamp = stamp;
+	slot.event.start = start;
+	slot.event.duration = duration;
+	slot.sequence.store(2*index+2, std::memory_order_release);
+
+	if(msg)
+	{
+		msg->stages.push_back(stage);
+		msg->start.push_back(start);
+		msg->duration.push_back(duration);
+	}
+}
+
+std::vector<LatencyTracer::Event> LatencyTracer::snapshot() const
+{
+	std::vector<Event> events;
+	unsigned long long head = head_.load(std::memory_order_acquire);
+	unsigned long long first = head > slots_.size()?head-slots_.size():0;
+	events.reserve(head-first);
+	for(unsigned long long i=first; i<head; ++i)
+	{
+		const Slot & slot = slots_[i % slots_.size()];
+		unsigned long long before = slot.sequence.load(std::memory_order_acquire);
+		Event event = slot.event;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		unsigned long long after = slot.sequence.load(std::memory_order_relaxed);
+		// skip events being written or already overwritten
+		if(before == 2*i+2 && after == before)
+		{
+			events.push_back(event);
+		}
+	}
+	return events;
+}
+
+bool LatencyTracer::exportCSV(const std::string & path) const
+{
+	std::ofstream file(path.c_str());
+	if(!file.is_open())
+	{
+		UERROR("Cannot open \"%s\" to export latency trace.", path.c_str());
+		return false;
+	}
+	std::vector<Event> events = snapshot();
+	file << "stamp,stage,start,duration" << std::endl;
+	file << std::fixed << std::setprecision(6);
+	for(unsigned int i=0; i<events.size(); ++i)
+	{
+		file << events[i].stamp << "," << events[i].stage << "," << events[i].start << "," << events[i].duration << std::endl;
+	}
+	UINFO("Exported %d latency events to \"%s\"", (int)events.size(), path.c_str());
+	return true;
+}
+
+bool LatencyTracer::exportChromeTrace(const std::string & path, const std::string & processName) const
+{
+	std::ofstream file(path.c_str());
+	if(!file.is_open())
+	{
+		UERROR("Cannot open \"%s\" to export latency trace.", path.c_str());
+		return false;
+	}
+	std::vector<Event> events = snapshot();
+	file << std::fixed << std::setprecision(3);
+	file << "{\"traceEvents\":[" << std::endl;
+	file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"" << processName << "\"}}";
+	for(unsigned int i=0; i<events.size(); ++i)
+	{
+		// timestamps in microseconds
+		file << "," << std::endl << "{\"name\":\"" << events[i].stage << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+			 << "\"ts\":" << events[i].start*1000000.0 << ",\"dur\":" << events[i].duration*1000000.0 << ","
+			 << "\"args\":{\"stamp\":" << events[i].stamp << "}}";
+	}
+	file << std::endl << "]}" << std::endl;
+	UINFO("Exported %d latency events to \"%s\"", (int)events.size(), path.c_str());
+	return true;
+}
+
+bool LatencyTracer::exportFile(const std::string & path, const std::string & processName) const
+{
+	if(uToLowerCase(UFile::getExtension(path)).compare("json") == 0)
+	{
+		return exportChromeTrace(path, processName);
+	}
+	return exportCSV(path);
+}
+
+} /* namespace rtabmap_ros */
@@ -41,6 +41,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <pcl/search/kdtree.h>
 
+#include <atomic>
+#include <thread>
+
 #include <pcl_conversions/pcl_conversions.h>
 
 #ifdef WITH_OCTOMAP_MSGS
@@ -62,10 +65,18 @@ MapsManager::MapsManager() :
 		mapCacheCleanup_(true),
 		alwaysUpdateMap_(false),
 		scanEmptyRayTracing_(true),
+		mapUpdateThreads_(0),
 		assembledObstacles_(new pcl::PointCloud<pcl::PointXYZRGB>),
 		assembledGround_(new pcl::PointCloud<pcl::PointXYZRGB>),
+		assembledObstaclesBuffer_(new pcl::PointCloud<pcl::PointXYZRGB>),
+		assembledGroundBuffer_(new pcl::PointCloud<pcl::PointXYZRGB>),
+		assembledGroundIndexDirty_(false),
+		assembledObstacleIndexDirty_(false),
 		occupancyGrid_(new OccupancyGrid),
 		gridUpdated_(true),
+		gridWorkersJobId_(0),
+		gridWorkersPending_(0),
+		gridWorkersStop_(false),
 		octomap_(0),
 		octomapTreeDepth_(16),
 		octomapUpdated_(true),
@@ -82,6 +93,11 @@ void MapsManager::init(rclcpp::Node & node, const std::string & name, bool)
 	alwaysUpdateMap_ = node.declare_parameter("map_always_update", rclcpp::ParameterValue(alwaysUpdateMap_)).get<bool>();
 
 	scanEmptyRayTracing_ = node.declare_parameter("map_empty_ray_tracing", rclcpp::ParameterValue(scanEmptyRayTracing_)).get<bool>();
+	mapUpdateThreads_ = node.declare_parameter("map_update_threads", rclcpp::ParameterValue(mapUpdateThreads_)).get<int>();
+	if(mapUpdateThreads_ <= 0)
+	{
+		mapUpdateThreads_ = std::max(1, (int)std::thread::hardware_concurrency());
+	}
 	cloudOutputVoxelized_ = node.declare_parameter("cloud_output_voxelized", rclcpp::ParameterValue(cloudOutputVoxelized_)).get<bool>();
 	cloudSubtractFiltering_ = node.declare_parameter("cloud_subtract_filtering", rclcpp::ParameterValue(cloudSubtractFiltering_)).get<bool>();
 	cloudSubtractFilteringMinNeighbors_ = node.declare_parameter("cloud_subtract_filtering_min_neighbors", rclcpp::ParameterValue(cloudSubtractFilteringMinNeighbors_)).get<int>();
@@ -96,6 +112,7 @@ void MapsManager::init(rclcpp::Node & node, const std::string & name, bool)
 	RCLCPP_INFO(node.get_logger(), "%s(maps): map_cleanup                = %s", name.c_str(), mapCacheCleanup_?"true":"false");
 	RCLCPP_INFO(node.get_logger(), "%s(maps): map_always_update          = %s", name.c_str(), alwaysUpdateMap_?"true":"false");
 	RCLCPP_INFO(node.get_logger(), "%s(maps): map_empty_ray_tracing      = %s", name.c_str(), scanEmptyRayTracing_?"true":"false");
+	RCLCPP_INFO(node.get_logger(), "%s(maps): map_update_threads         = %d", name.c_str(), mapUpdateThreads_);
 	RCLCPP_INFO(node.get_logger(), "%s(maps): cloud_output_voxelized     = %s", name.c_str(), cloudOutputVoxelized_?"true":"false");
 	RCLCPP_INFO(node.get_logger(), "%s(maps): cloud_subtract_filtering   = %s", name.c_str(), cloudSubtractFiltering_?"true":"false");
 	RCLCPP_INFO(node.get_logger(), "%s(maps): cloud_subtract_filtering_min_neighbors = %d", name.c_str(), cloudSubtractFilteringMinNeighbors_);
@@ -156,6 +173,7 @@ void MapsManager::init(rclcpp::Node & node, const std::string & name, bool)
 }
 
 MapsManager::~MapsManager() {
+	stopGridWorkers();
 	clear();
 
 	delete occupancyGrid_;
@@ -239,6 +257,10 @@ void MapsManager::setParameters(const rtabmap::ParametersMap & parameters)
 {
 	parameters_ = parameters;
 	occupancyGrid_->parseParameters(parameters_);
+	for(size_t i=0; i<gridWorkerGrids_.size(); ++i)
+	{
+		gridWorkerGrids_[i]->parseParameters(parameters_);
+	}
 
 #ifdef WITH_OCTOMAP_MSGS
 #ifdef RTABMAP_OCTOMAP
@@ -306,10 +328,20 @@ void MapsManager::clear()
 	gridMapsViewpoints_.clear();
 	assembledGround_->clear();
 	assembledObstacles_->clear();
+	assembledGroundBuffer_->clear();
+	assembledObstaclesBuffer_->clear();
+	assembledGroundBlocks_.clear();
+	assembledObstacleBlocks_.clear();
 	assembledGroundPoses_.clear();
 	assembledObstaclePoses_.clear();
-	assembledGroundIndex_.release();
-	assembledObstacleIndex_.release();
+	assembledGroundTmp_.clear();
+	assembledObstaclesTmp_.clear();
+	assembledGroundVoxels_.clear();
+	assembledObstacleVoxels_.clear();
+	assembledGroundIndex_.clear();
+	assembledObstacleIndex_.clear();
+	assembledGroundIndexDirty_ = false;
+	assembledObstacleIndexDirty_ = false;
 	groundClouds_.clear();
 	obstacleClouds_.clear();
 	occupancyGrid_->clear();
@@ -350,12 +382,184 @@ std::map<int, Transform> MapsManager::getFilteredPoses(const std::map<int, Trans
 	return std::map<int, Transform>();
 }
 
+void warnGridRegenerated(int id)
+{
+	static bool warningShown = false;
+	if(!warningShown)
+	{
+		warningShown = true;
+		UWARN("Occupancy grid for location %d should be added to global map (e..g, a ROS node is subscribed to "
+				"any occupancy grid output) but it cannot be found "
+				"in memory. For convenience, the occupancy "
+				"grid is regenerated. Make sure parameter \"%s\" is true to "
+				"avoid this warning for the next locations added to map. For older "
+				"locations already in database without an occupancy grid map, you can use the "
+				"\"rtabmap-databaseViewer\" to regenerate the missing occupancy grid maps and "
+				"save them back in the database for next sessions. This warning is only shown once.",
+				id, Parameters::kRGBDCreateOccupancyGrid().c_str());
+	}
+}
+
+void MapsManager::loadGridMapsParallel(
+		const std::map<int, rtabmap::Transform> & poses,
+		const rtabmap::Memory * memory,
+		const std::map<int, rtabmap::Signature> & signatures,
+		std::mutex * memoryMutex,
+		bool occupancySavedInDB)
+{
+	std::vector<std::pair<int, Transform> > nodes(poses.begin(), poses.end());
+	std::vector<std::pair<std::pair<cv::Mat, cv::Mat>, cv::Mat> > grids(nodes.size());
+	std::vector<cv::Point3f> viewPoints(nodes.size());
+	std::vector<bool> regenerated(nodes.size(), false);
+
+	// Memory is not thread-safe, serialize access to it
+	std::mutex localMemoryMutex;
+	std::mutex & dbMutex = memoryMutex?*memoryMutex:localMemoryMutex;
+	std::atomic<int> next(0);
+
+	UTimer timer;
+	runGridWorkers([&](int worker)
+	{
+		OccupancyGrid * occupancyGrid = gridWorkerGrids_[worker];
+		int i;
+		while((i=next++) < (int)nodes.size())
+		{
+			int id = nodes[i].first;
+			rtabmap::SensorData data;
+			std::map<int, rtabmap::Signature>::const_iterator findIter = signatures.find(id);
+			if(findIter != signatures.end())
+			{
+				data = findIter->second.sensorData();
+			}
+			else if(memory)
+			{
+				dbMutex.lock();
+				data = memory->getNodeData(id, occupancyGrid->isGridFromDepth() && !occupancySavedInDB, !occupancyGrid->isGridFromDepth() && !occupancySavedInDB, false, true);
+				dbMutex.unlock();
+			}
+
+			cv::Mat rgb, depth;
+			LaserScan scan;
+			cv::Mat & ground = grids[i].first.first;
+			cv::Mat & obstacles = grids[i].first.second;
+			cv::Mat & emptyCells = grids[i].second;
+			bool generateGrid = data.gridCellSize() == 0.0f;
+			if(memory && occupancySavedInDB && generateGrid)
+			{
+				// old nodes without occupancy grid, reload raw data
+				regenerated[i] = true;
+				dbMutex.lock();
+				data = memory->getNodeData(id, occupancyGrid->isGridFromDepth(), !occupancyGrid->isGridFromDepth(), false, false);
+				dbMutex.unlock();
+			}
+			data.uncompressData(
+					occupancyGrid->isGridFromDepth() && generateGrid?&rgb:0,
+					occupancyGrid->isGridFromDepth() && generateGrid?&depth:0,
+					!occupancyGrid->isGridFromDepth() && generateGrid?&scan:0,
+					0,
+					generateGrid?0:&ground,
+					generateGrid?0:&obstacles,
+					generateGrid?0:&emptyCells);
+
+			if(generateGrid)
+			{
+				Signature tmp(data);
+				tmp.setPose(nodes[i].second);
+				occupancyGrid->createLocalMap(tmp, ground, obstacles, emptyCells, viewPoints[i]);
+			}
+			else
+			{
+				viewPoints[i] = data.gridViewPoint();
+			}
+		}
+	});
+
+	// merge in id order
+	for(unsigned int i=0; i<nodes.size(); ++i)
+	{
+		if(regenerated[i])
+		{
+			warnGridRegenerated(nodes[i].first);
+		}
+		uInsert(gridMaps_, std::make_pair(nodes[i].first, grids[i]));
+		uInsert(gridMapsViewpoints_, std::make_pair(nodes[i].first, viewPoints[i]));
+	}
+	UINFO("Loaded %d local grids with %d threads (%f s)", (int)nodes.size(), (int)gridWorkers_.size(), timer.ticks());
+}
+
+void MapsManager::runGridWorkers(const std::function<void(int)> & job)
+{
+	std::unique_lock<std::mutex> lock(gridWorkersMutex_);
+	if(gridWorkers_.empty())
+	{
+		for(int i=0; i<mapUpdateThreads_; ++i)
+		{
+			gridWorkerGrids_.push_back(new OccupancyGrid);
+			gridWorkerGrids_.back()->parseParameters(parameters_);
+			gridWorkers_.push_back(new std::thread(&MapsManager::gridWorkerLoop, this, i));
+		}
+	}
+	gridWorkersJob_ = job;
+	gridWorkersPending_ = (int)gridWorkers_.size();
+	++gridWorkersJobId_;
+	gridWorkersCondition_.notify_all();
+	gridWorkersDoneCondition_.wait(lock, [this](){return gridWorkersPending_ == 0;});
+	gridWorkersJob_ = std::function<void(int)>();
+}
+
+void MapsManager::gridWorkerLoop(int index)
+{
+	unsigned int lastJobId = 0;
+	while(true)
+	{
+		std::function<void(int)> job;
+		{
+			std::unique_lock<std::mutex> lock(gridWorkersMutex_);
+			gridWorkersCondition_.wait(lock, [&](){return gridWorkersStop_ || gridWorkersJobId_ != lastJobId;});
+			if(gridWorkersStop_)
+			{
+				return;
+			}
+			lastJobId = gridWorkersJobId_;
+			job = gridWorkersJob_;
+		}
+		job(index);
+		{
+			std::unique_lock<std::mutex> lock(gridWorkersMutex_);
+			if(--gridWorkersPending_ == 0)
+			{
+				gridWorkersDoneCondition_.notify_one();
+			}
+		}
+	}
+}
+
+void MapsManager::stopGridWorkers()
+{
+	gridWorkersMutex_.lock();
+	gridWorkersStop_ = true;
+	gridWorkersMutex_.unlock();
+	gridWorkersCondition_.notify_all();
+	for(size_t i=0; i<gridWorkers_.size(); ++i)
+	{
+		gridWorkers_[i]->join();
+		delete gridWorkers_[i];
+	}
+	gridWorkers_.clear();
+	for(size_t i=0; i<gridWorkerGrids_.size(); ++i)
+	{
+		delete gridWorkerGrids_[i];
+	}
+	gridWorkerGrids_.clear();
+}
+
 std::map<int, rtabmap::Transform> MapsManager::updateMapCaches(
 		const std::map<int, rtabmap::Transform> & posesIn,
 		const rtabmap::Memory * memory,
 		bool updateGrid,
 		bool updateOctomap,
-		const std::map<int, rtabmap::Signature> & signatures)
+		const std::map<int, rtabmap::Signature> & signatures,
+		std::mutex * memoryMutex)
 {
 	bool updateGridCache = updateGrid || updateOctomap;
 	if(!updateGrid && !updateOctomap)
@@ -456,6 +660,24 @@ std::map<int, rtabmap::Transform> MapsManager::updateMapCaches(
 
 		bool occupancySavedInDB = memory && uStrNumCmp(memory->getDatabaseVersion(), "0.11.10")>=0?true:false;
 
+		if(mapUpdateThreads_ > 1)
+		{
+			// Load and generate missing local grids in parallel, the latest
+			// node (id=0) is still processed below as it may change the parameters.
+			std::map<int, rtabmap::Transform> missingGrids;
+			for(std::map<int, rtabmap::Transform>::iterator iter=filteredPoses.lower_bound(1); iter!=filteredPoses.end(); ++iter)
+			{
+				if(!iter->second.isNull() && !uContains(gridMaps_, iter->first))
+				{
+					missingGrids.insert(*iter);
+				}
+			}
+			if(missingGrids.size() > 1)
+			{
+				loadGridMapsParallel(missingGrids, memory, signatures, memoryMutex, occupancySavedInDB);
+			}
+		}
+
 		for(std::map<int, rtabmap::Transform>::iterator iter=filteredPoses.begin(); iter!=filteredPoses.end(); ++iter)
 		{
 			if(!iter->second.isNull())
@@ -471,7 +693,15 @@ std::map<int, rtabmap::Transform> MapsManager::updateMapCaches(
 					}
 					else if(memory)
 					{
+						if(memoryMutex)
+						{
+							memoryMutex->lock();
+						}
 						data = memory->getNodeData(iter->first, occupancyGrid_->isGridFromDepth() && !occupancySavedInDB, !occupancyGrid_->isGridFromDepth() && !occupancySavedInDB, false, true);
+						if(memoryMutex)
+						{
+							memoryMutex->unlock();
+						}
 					}
 
 					UDEBUG("Adding grid map %d to cache...", iter->first);
@@ -482,25 +712,23 @@ std::map<int, rtabmap::Transform> MapsManager::updateMapCaches(
 						cv::Mat rgb, depth;
 						LaserScan scan;
 						bool generateGrid = data.gridCellSize() == 0.0f;
-						static bool warningShown = false;
-						if(occupancySavedInDB && generateGrid && !warningShown)
+						if(occupancySavedInDB && generateGrid)
 						{
-							warningShown = true;
-							UWARN("Occupancy grid for location %d should be added to global map (e..g, a ROS node is subscribed to "
-									"any occupancy grid output) but it cannot be found "
-									"in memory. For convenience, the occupancy "
-									"grid is regenerated. Make sure parameter \"%s\" is true to "
-									"avoid this warning for the next locations added to map. For older "
-									"locations already in database without an occupancy grid map, you can use the "
-									"\"rtabmap-databaseViewer\" to regenerate the missing occupancy grid maps and "
-									"save them back in the database for next sessions. This warning is only shown once.",
-									data.id(), Parameters::kRGBDCreateOccupancyGrid().c_str());
+							warnGridRegenerated(data.id());
 						}
 						if(memory && occupancySavedInDB && generateGrid)
 						{
 							// if we are here, it is because we loaded a database with old nodes not having occupancy grid set
 							// try reload again
+							if(memoryMutex)
+							{
+								memoryMutex->lock();
+							}
 							data = memory->getNodeData(iter->first, occupancyGrid_->isGridFromDepth(), !occupancyGrid_->isGridFromDepth(), false, false);
+							if(memoryMutex)
+							{
+								memoryMutex->unlock();
+							}
 						}
 						data.uncompressData(
 								occupancyGrid_->isGridFromDepth() && generateGrid?&rgb:0,
@@ -689,31 +917,114 @@ std::map<int, rtabmap::Transform> MapsManager::updateMapCaches(
 	return filteredPoses;
 }
 
-pcl::PointCloud<pcl::PointXYZRGB>::Ptr subtractFiltering(
-		const pcl::PointCloud<pcl::PointXYZRGB>::Ptr & cloud,
-		const rtabmap::FlannIndex & substractCloudIndex,
-		float radiusSearch,
-		int minNeighborsInRadius)
+bool assembledPoseChanged(const Transform & before, const Transform & after)
+{
+	if(after.getDistanceSquared(before) > 0.0001) // 1 cm
+	{
+		return true;
+	}
+	float roll, pitch, yaw;
+	(before.inverse() * after).getEulerAngles(roll, pitch, yaw);
+	return fabs(roll) > 0.01 || fabs(pitch) > 0.01 || fabs(yaw) > 0.01; // ~0.5 deg
+}
+
+// Re-transform in place the blocks (<offset, size>) of the nodes that moved since
+// they have been assembled. Blocks of nodes not in the graph anymore are removed
+// and the buffer is compacted. If set, the voxel grid and the index are updated
+// only for the points of these blocks. Returns the number of blocks re-transformed.
+int updateAssembledBlocks(
+		const std::map<int, Transform> & poses,
+		const std::map<int, pcl::PointCloud<pcl::PointXYZRGB>::Ptr > & localClouds,
+		std::map<int, Transform> & assembledPoses,
+		std::map<int, std::pair<int, int> > & blocks,
+		pcl::PointCloud<pcl::PointXYZRGB> & buffer,
+		PointCloudVoxelGrid * voxels,
+		PointCloudVoxelHash * index)
 {
-	UASSERT(minNeighborsInRadius > 0);
-	UASSERT(substractCloudIndex.indexedFeatures());
+	int moved = 0;
+	bool removed = false;
+	for(std::map<int, Transform>::iterator iter=assembledPoses.begin(); iter!=assembledPoses.end();)
+	{
+		std::map<int, Transform>::const_iterator pter = poses.find(iter->first);
+		std::map<int, std::pair<int, int> >::iterator bter = blocks.find(iter->first);
+		std::map<int, pcl::PointCloud<pcl::PointXYZRGB>::Ptr >::const_iterator cter = localClouds.find(iter->first);
+		if(pter == poses.end() ||
+		   (bter != blocks.end() && (cter == localClouds.end() || (int)cter->second->size() != bter->second.second)))
+		{
+			// not in the graph anymore (or local cloud not cached anymore), it will be re-added if needed
+			if(bter != blocks.end())
+			{
+				if(voxels)
+				{
+					voxels->removePoints(buffer, bter->second.first, bter->second.second);
+				}
+				if(index)
+				{
+					index->removePoints(buffer, bter->second.first, bter->second.second);
+				}
+				blocks.erase(bter);
+			}
+			assembledPoses.erase(iter++);
+			removed = true;
+			continue;
+		}
+		if(assembledPoseChanged(iter->second, pter->second))
+		{
+			if(bter != blocks.end())
+			{
+				if(voxels)
+				{
+					voxels->removePoints(buffer, bter->second.first, bter->second.second);
+				}
+				if(index)
+				{
+					index->removePoints(buffer, bter->second.first, bter->second.second);
+				}
+				Eigen::Affine3f t = pter->second.toEigen3f();
+				const pcl::PointCloud<pcl::PointXYZRGB> & local = *cter->second;
+				for(int i=0; i<bter->second.second; ++i)
+				{
+					buffer.at(bter->second.first + i).getVector3fMap() = t * local.at(i).getVector3fMap();
+				}
+				if(voxels)
+				{
+					voxels->addPoints(buffer, bter->second.first, bter->second.second);
+				}
+				if(index)
+				{
+					index->addPoints(buffer, bter->second.first, bter->second.second);
+				}
+				++moved;
+			}
+			iter->second = pter->second;
+		}
+		++iter;
+	}
 
-	pcl::PointCloud<pcl::PointXYZRGB>::Ptr output(new pcl::PointCloud<pcl::PointXYZRGB>);
-	output->resize(cloud->size());
-	int oi = 0; // output iterator
-	for(unsigned int i=0; i<cloud->size(); ++i)
+	if(removed)
 	{
-		std::vector<std::vector<size_t> > kIndices;
-		std::vector<std::vector<float> > kDistances;
-		cv::Mat pt = (cv::Mat_<float>(1, 3) << cloud->at(i).x, cloud->at(i).y, cloud->at(i).z);
-		substractCloudIndex.radiusSearch(pt, kIndices, kDistances, radiusSearch, minNeighborsInRadius, 32, 0, false);
-		if(kIndices.size() == 1 && int(kIndices[0].size()) < minNeighborsInRadius)
+		// compact the buffer, blocks are moved in offset order
+		std::vector<std::pair<int, int> > offsets; // <offset, id>
+		offsets.reserve(blocks.size());
+		for(std::map<int, std::pair<int, int> >::iterator iter=blocks.begin(); iter!=blocks.end(); ++iter)
+		{
+			offsets.push_back(std::make_pair(iter->second.first, iter->first));
+		}
+		std::sort(offsets.begin(), offsets.end());
+		int oi = 0;
+		for(unsigned int i=0; i<offsets.size(); ++i)
 		{
-			output->at(oi++) = cloud->at(i);
+			std::pair<int, int> & block = blocks.at(offsets[i].second);
+			if(block.first != oi)
+			{
+				std::copy(buffer.begin()+block.first, buffer.begin()+block.first+block.second, buffer.begin()+oi);
+				block.first = oi;
+			}
+			oi += block.second;
 		}
+		buffer.resize(oi);
 	}
-	output->resize(oi);
-	return output;
+	return moved;
 }
 
 void MapsManager::publishMaps(
@@ -750,7 +1061,7 @@ void MapsManager::publishMaps(
 				{
 					graphGroundChanged = false;
 					UASSERT(!iter->second.isNull() && !jter->second.isNull());
-					if(iter->second.getDistanceSquared(jter->second) > 0.0001)
+					if(assembledPoseChanged(jter->second, iter->second))
 					{
 						graphGroundOptimized = true;
 					}
@@ -763,7 +1074,7 @@ void MapsManager::publishMaps(
 				{
 					graphObstacleChanged = false;
 					UASSERT(!iter->second.isNull() && !jter->second.isNull());
-					if(iter->second.getDistanceSquared(jter->second) > 0.0001)
+					if(assembledPoseChanged(jter->second, iter->second))
 					{
 						graphObstacleOptimized = true;
 					}
@@ -772,105 +1083,103 @@ void MapsManager::publishMaps(
 		}
 		int countObstacles = 0;
 		int countGrounds = 0;
-		int previousIndexedGroundSize = assembledGroundIndex_.indexedFeatures();
-		int previousIndexedObstacleSize = assembledObstacleIndex_.indexedFeatures();
-		if(graphGroundOptimized || graphGroundChanged)
+		bool groundReassembled = false;
+		bool obstaclesReassembled = false;
+		if(graphGroundChanged)
 		{
-			int previousSize = assembledGround_->size();
 			assembledGround_->clear();
-			assembledGround_->reserve(previousSize);
+			assembledGroundBuffer_->clear();
+			assembledGroundBlocks_.clear();
 			assembledGroundPoses_.clear();
-			assembledGroundIndex_.release();
+			assembledGroundTmp_.clear();
+			assembledGroundVoxels_.clear();
+			assembledGroundIndex_.clear();
+			assembledGroundIndexDirty_ = false;
 		}
-		if(graphObstacleOptimized || graphObstacleChanged )
+		if(graphObstacleChanged)
 		{
-			int previousSize = assembledObstacles_->size();
 			assembledObstacles_->clear();
-			assembledObstacles_->reserve(previousSize);
+			assembledObstaclesBuffer_->clear();
+			assembledObstacleBlocks_.clear();
 			assembledObstaclePoses_.clear();
-			assembledObstacleIndex_.release();
+			assembledObstaclesTmp_.clear();
+			assembledObstacleVoxels_.clear();
+			assembledObstacleIndex_.clear();
+			assembledObstacleIndexDirty_ = false;
+		}
+
+		// remove the points of the temporary nodes added at the previous update
+		if(updateGround && assembledGroundTmp_.size())
+		{
+			if(cloudOutputVoxelized_)
+			{
+				assembledGroundVoxels_.removePoints(assembledGroundTmp_);
+			}
+			if(cloudSubtractFiltering_ && !assembledGroundIndexDirty_)
+			{
+				assembledGroundIndex_.removePoints(assembledGroundTmp_);
+			}
+			assembledGroundTmp_.clear();
+		}
+		if(updateObstacles && assembledObstaclesTmp_.size())
+		{
+			if(cloudOutputVoxelized_)
+			{
+				assembledObstacleVoxels_.removePoints(assembledObstaclesTmp_);
+			}
+			if(cloudSubtractFiltering_ && !assembledObstacleIndexDirty_)
+			{
+				assembledObstacleIndex_.removePoints(assembledObstaclesTmp_);
+			}
+			assembledObstaclesTmp_.clear();
+		}
+		if(cloudOutputVoxelized_)
+		{
+			UASSERT(occupancyGrid_->getCellSize() > 0.0);
+			if(updateGround && assembledGroundVoxels_.setVoxelSize(occupancyGrid_->getCellSize()))
+			{
+				// cell size changed, voxelize again all assembled clouds
+				assembledGroundVoxels_.addPoints(*assembledGroundBuffer_);
+			}
+			if(updateObstacles && assembledObstacleVoxels_.setVoxelSize(occupancyGrid_->getCellSize()))
+			{
+				// cell size changed, voxelize again all assembled clouds
+				assembledObstacleVoxels_.addPoints(*assembledObstaclesBuffer_);
+			}
 		}
 
 		if(graphGroundOptimized || graphObstacleOptimized)
 		{
 			UINFO("Graph has changed, updating clouds...");
 			UTimer t;
-			cv::Mat tmpGroundPts;
-			cv::Mat tmpObstaclePts;
-			for(std::map<int, Transform>::const_iterator iter = poses.begin(); iter!=poses.end(); ++iter)
+			int movedGrounds = 0;
+			int movedObstacles = 0;
+			if(graphGroundOptimized)
 			{
-				if(iter->first > 0)
+				movedGrounds = updateAssembledBlocks(poses, groundClouds_, assembledGroundPoses_, assembledGroundBlocks_, *assembledGroundBuffer_,
+						cloudOutputVoxelized_?&assembledGroundVoxels_:0,
+						cloudSubtractFiltering_ && !assembledGroundIndexDirty_?&assembledGroundIndex_:0);
+				if(!cloudOutputVoxelized_)
 				{
-					if(updateGround  &&
-					   (graphGroundOptimized || assembledGroundPoses_.find(iter->first) == assembledGroundPoses_.end()))
-					{
-						assembledGroundPoses_.insert(*iter);
-						std::map<int, pcl::PointCloud<pcl::PointXYZRGB>::Ptr >::iterator kter=groundClouds_.find(iter->first);
-						if(kter != groundClouds_.end() && kter->second->size())
-						{
-							pcl::PointCloud<pcl::PointXYZRGB>::Ptr transformed = util3d::transformPointCloud(kter->second, iter->second);
-							*assembledGround_+=*transformed;
-							if(cloudSubtractFiltering_)
-							{
-								for(unsigned int i=0; i<transformed->size(); ++i)
-								{
-									if(tmpGroundPts.empty())
-									{
-										tmpGroundPts = (cv::Mat_<float>(1, 3) << transformed->at(i).x, transformed->at(i).y, transformed->at(i).z);
-										tmpGroundPts.reserve(previousIndexedGroundSize>0?previousIndexedGroundSize:100);
-									}
-									else
-									{
-										cv::Mat pt = (cv::Mat_<float>(1, 3) << transformed->at(i).x, transformed->at(i).y, transformed->at(i).z);
-										tmpGroundPts.push_back(pt);
-									}
-								}
-							}
-							++countGrounds;
-						}
-					}
-					if(updateObstacles  &&
-					   (graphObstacleOptimized || assembledObstaclePoses_.find(iter->first) == assembledObstaclePoses_.end()))
-					{
-						assembledObstaclePoses_.insert(*iter);
-						std::map<int, pcl::PointCloud<pcl::PointXYZRGB>::Ptr >::iterator kter=obstacleClouds_.find(iter->first);
-						if(kter != obstacleClouds_.end() && kter->second->size())
-						{
-							pcl::PointCloud<pcl::PointXYZRGB>::Ptr transformed = util3d::transformPointCloud(kter->second, iter->second);
-							*assembledObstacles_+=*transformed;
-							if(cloudSubtractFiltering_)
-							{
-								for(unsigned int i=0; i<transformed->size(); ++i)
-								{
-									if(tmpObstaclePts.empty())
-									{
-										tmpObstaclePts = (cv::Mat_<float>(1, 3) << transformed->at(i).x, transformed->at(i).y, transformed->at(i).z);
-										tmpObstaclePts.reserve(previousIndexedObstacleSize>0?previousIndexedObstacleSize:100);
-									}
-									else
-									{
-										cv::Mat pt = (cv::Mat_<float>(1, 3) << transformed->at(i).x, transformed->at(i).y, transformed->at(i).z);
-										tmpObstaclePts.push_back(pt);
-									}
-								}
-							}
-							++countObstacles;
-						}
-					}
+					*assembledGround_ = *assembledGroundBuffer_;
 				}
+				groundReassembled = true;
 			}
-			double addingPointsTime = t.ticks();
-
-			if(graphGroundOptimized && !tmpGroundPts.empty())
-			{
-				assembledGroundIndex_.buildKDTreeSingleIndex(tmpGroundPts, 15);
-			}
-			if(graphObstacleOptimized && !tmpObstaclePts.empty())
+			if(graphObstacleOptimized)
 			{
-				assembledObstacleIndex_.buildKDTreeSingleIndex(tmpObstaclePts, 15);
+				movedObstacles = updateAssembledBlocks(poses, obstacleClouds_, assembledObstaclePoses_, assembledObstacleBlocks_, *assembledObstaclesBuffer_,
+						cloudOutputVoxelized_?&assembledObstacleVoxels_:0,
+						cloudSubtractFiltering_ && !assembledObstacleIndexDirty_?&assembledObstacleIndex_:0);
+				if(!cloudOutputVoxelized_)
+				{
+					*assembledObstacles_ = *assembledObstaclesBuffer_;
+				}
+				obstaclesReassembled = true;
 			}
-			double indexingTime = t.ticks();
-			UINFO("Graph optimized! Time recreating clouds (%d ground, %d obstacles) = %f s (indexing %fs)", countGrounds, countObstacles, addingPointsTime+indexingTime, indexingTime);
+			UINFO("Graph optimized! Time updating clouds (%d/%d ground, %d/%d obstacles moved) = %f s",
+					movedGrounds, (int)assembledGroundBlocks_.size(),
+					movedObstacles, (int)assembledObstacleBlocks_.size(),
+					t.ticks());
 		}
 		else if(graphGroundChanged || graphObstacleChanged)
 		{
@@ -892,37 +1201,50 @@ void MapsManager::publishMaps(
 					pcl::PointCloud<pcl::PointXYZRGB>::Ptr subtractedCloud = transformed;
 					if(cloudSubtractFiltering_)
 					{
-						if(assembledGroundIndex_.indexedFeatures())
+						if(assembledGroundIndex_.radius() != occupancyGrid_->getCellSize())
+						{
+							assembledGroundIndex_.setRadius(occupancyGrid_->getCellSize());
+							assembledGroundIndexDirty_ = true;
+						}
+						if(assembledGroundIndexDirty_)
 						{
-							subtractedCloud = subtractFiltering(transformed, assembledGroundIndex_, occupancyGrid_->getCellSize(), cloudSubtractFilteringMinNeighbors_);
+							assembledGroundIndex_.clear();
+							assembledGroundIndex_.addPoints(*assembledGroundBuffer_);
+							assembledGroundIndexDirty_ = false;
+						}
+						if(!assembledGroundIndex_.empty())
+						{
+							subtractedCloud = assembledGroundIndex_.subtract(*transformed, cloudSubtractFilteringMinNeighbors_);
 						}
 						if(subtractedCloud->size())
 						{
-							UDEBUG("Adding ground %d pts=%d/%d (index=%d)", iter->first, subtractedCloud->size(), transformed->size(), assembledGroundIndex_.indexedFeatures());
-							cv::Mat pts(subtractedCloud->size(), 3, CV_32FC1);
-							for(unsigned int i=0; i<subtractedCloud->size(); ++i)
-							{
-								pts.at<float>(i, 0) = subtractedCloud->at(i).x;
-								pts.at<float>(i, 1) = subtractedCloud->at(i).y;
-								pts.at<float>(i, 2) = subtractedCloud->at(i).z;
-							}
-							if(!assembledGroundIndex_.isBuilt())
-							{
-								assembledGroundIndex_.buildKDTreeSingleIndex(pts, 15);
-							}
-							else
-							{
-								assembledGroundIndex_.addPoints(pts);
-							}
+							UDEBUG("Adding ground %d pts=%d/%d (index=%d)", iter->first, subtractedCloud->size(), transformed->size(), (int)assembledGroundIndex_.size());
+							assembledGroundIndex_.addPoints(*subtractedCloud);
 						}
 					}
 					if(iter->first>0)
 					{
-						groundClouds_.insert(std::make_pair(iter->first, util3d::transformPointCloud(subtractedCloud, iter->second.inverse())));
+						uInsert(groundClouds_, std::make_pair(iter->first, util3d::transformPointCloud(subtractedCloud, iter->second.inverse())));
+						if(subtractedCloud->size())
+						{
+							uInsert(assembledGroundBlocks_, std::make_pair(iter->first, std::make_pair((int)assembledGroundBuffer_->size(), (int)subtractedCloud->size())));
+							*assembledGroundBuffer_+=*subtractedCloud;
+						}
+					}
+					else
+					{
+						assembledGroundTmp_ += *subtractedCloud;
 					}
 					if(subtractedCloud->size())
 					{
-						*assembledGround_+=*subtractedCloud;
+						if(cloudOutputVoxelized_)
+						{
+							assembledGroundVoxels_.addPoints(*subtractedCloud);
+						}
+						else
+						{
+							*assembledGround_+=*subtractedCloud;
+						}
 					}
 					++countGrounds;
 				}
@@ -939,37 +1261,50 @@ void MapsManager::publishMaps(
 					pcl::PointCloud<pcl::PointXYZRGB>::Ptr subtractedCloud = transformed;
 					if(cloudSubtractFiltering_)
 					{
-						if(assembledObstacleIndex_.indexedFeatures())
+						if(assembledObstacleIndex_.radius() != occupancyGrid_->getCellSize())
+						{
+							assembledObstacleIndex_.setRadius(occupancyGrid_->getCellSize());
+							assembledObstacleIndexDirty_ = true;
+						}
+						if(assembledObstacleIndexDirty_)
 						{
-							subtractedCloud = subtractFiltering(transformed, assembledObstacleIndex_, occupancyGrid_->getCellSize(), cloudSubtractFilteringMinNeighbors_);
+							assembledObstacleIndex_.clear();
+							assembledObstacleIndex_.addPoints(*assembledObstaclesBuffer_);
+							assembledObstacleIndexDirty_ = false;
+						}
+						if(!assembledObstacleIndex_.empty())
+						{
+							subtractedCloud = assembledObstacleIndex_.subtract(*transformed, cloudSubtractFilteringMinNeighbors_);
 						}
 						if(subtractedCloud->size())
 						{
-							UDEBUG("Adding obstacle %d pts=%d/%d (index=%d)", iter->first, subtractedCloud->size(), transformed->size(), assembledObstacleIndex_.indexedFeatures());
-							cv::Mat pts(subtractedCloud->size(), 3, CV_32FC1);
-							for(unsigned int i=0; i<subtractedCloud->size(); ++i)
-							{
-								pts.at<float>(i, 0) = subtractedCloud->at(i).x;
-								pts.at<float>(i, 1) = subtractedCloud->at(i).y;
-								pts.at<float>(i, 2) = subtractedCloud->at(i).z;
-							}
-							if(!assembledObstacleIndex_.isBuilt())
-							{
-								assembledObstacleIndex_.buildKDTreeSingleIndex(pts, 15);
-							}
-							else
-							{
-								assembledObstacleIndex_.addPoints(pts);
-							}
+							UDEBUG("Adding obstacle %d pts=%d/%d (index=%d)", iter->first, subtractedCloud->size(), transformed->size(), (int)assembledObstacleIndex_.size());
+							assembledObstacleIndex_.addPoints(*subtractedCloud);
 						}
 					}
 					if(iter->first>0)
 					{
-						obstacleClouds_.insert(std::make_pair(iter->first, util3d::transformPointCloud(subtractedCloud, iter->second.inverse())));
+						uInsert(obstacleClouds_, std::make_pair(iter->first, util3d::transformPointCloud(subtractedCloud, iter->second.inverse())));
+						if(subtractedCloud->size())
+						{
+							uInsert(assembledObstacleBlocks_, std::make_pair(iter->first, std::make_pair((int)assembledObstaclesBuffer_->size(), (int)subtractedCloud->size())));
+							*assembledObstaclesBuffer_+=*subtractedCloud;
+						}
+					}
+					else
+					{
+						assembledObstaclesTmp_ += *subtractedCloud;
 					}
 					if(subtractedCloud->size())
 					{
-						*assembledObstacles_+=*subtractedCloud;
+						if(cloudOutputVoxelized_)
+						{
+							assembledObstacleVoxels_.addPoints(*subtractedCloud);
+						}
+						else
+						{
+							*assembledObstacles_+=*subtractedCloud;
+						}
 					}
 					++countObstacles;
 				}
@@ -978,15 +1313,9 @@ void MapsManager::publishMaps(
 
 		if(cloudOutputVoxelized_)
 		{
-			UASSERT(occupancyGrid_->getCellSize() > 0.0);
-			if(countGrounds && assembledGround_->size())
-			{
-				assembledGround_ = util3d::voxelize(assembledGround_, occupancyGrid_->getCellSize());
-			}
-			if(countObstacles && assembledObstacles_->size())
-			{
-				assembledObstacles_ = util3d::voxelize(assembledObstacles_, occupancyGrid_->getCellSize());
-			}
+			// only the voxels of the added, moved or removed nodes have been updated
+			assembledGround_ = assembledGroundVoxels_.cloud();
+			assembledObstacles_ = assembledObstacleVoxels_.cloud();
 		}
 
 		UINFO("Assembled %d obstacle and %d ground clouds (%d points, %fs)",
@@ -994,6 +1323,8 @@ void MapsManager::publishMaps(
 
 		if( countGrounds > 0 ||
 			countObstacles > 0 ||
+			groundReassembled ||
+			obstaclesReassembled ||
 			!latching_ ||
 			(assembledGround_->empty() && assembledObstacles_->empty()) ||
 			(cloudGroundPub_->get_subscription_count() && !latched_.at(&cloudGroundPub_)) ||
@@ -1038,10 +1369,20 @@ void MapsManager::publishMaps(
 	{
 		assembledGround_->clear();
 		assembledObstacles_->clear();
+		assembledGroundBuffer_->clear();
+		assembledObstaclesBuffer_->clear();
+		assembledGroundBlocks_.clear();
+		assembledObstacleBlocks_.clear();
 		assembledGroundPoses_.clear();
 		assembledObstaclePoses_.clear();
-		assembledGroundIndex_.release();
-		assembledObstacleIndex_.release();
+		assembledGroundTmp_.clear();
+		assembledObstaclesTmp_.clear();
+		assembledGroundVoxels_.clear();
+		assembledObstacleVoxels_.clear();
+		assembledGroundIndex_.clear();
+		assembledObstacleIndex_.clear();
+		assembledGroundIndexDirty_ = false;
+		assembledObstacleIndexDirty_ = false;
 		groundClouds_.clear();
 		obstacleClouds_.clear();
 	}
@@ -26,6 +26,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "rtabmap_ros/MsgConversion.h"
+#include "rtabmap_ros/DepthCodec.h"
+#include "rtabmap_ros/NodeDataCache.h"
 
 #include <opencv2/highgui/highgui.hpp>
 #include <zlib.h>
@@ -36,6 +38,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <rtabmap/core/Compression.h>
 #include <rtabmap/utilite/UStl.h>
 #include <rtabmap/utilite/ULogger.h>
+#include <rtabmap/utilite/UTimer.h>
 #include <pcl_conversions/pcl_conversions.h>
 #include <image_geometry/pinhole_camera_model.h>
 #include <image_geometry/stereo_camera_model.h>
@@ -47,6 +50,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <tf2_eigen/tf2_eigen.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <thread>
+
 namespace rtabmap_ros {
 
 void transformToTF(const rtabmap::Transform & transform, tf2::Transform & tfTransform)
@@ -131,6 +143,177 @@ rtabmap::Transform transformFromPoseMsg(const geometry_msgs::msg::Pose & msg)
 	return rtabmap::Transform::fromEigen3d(tfPose);
 }
 
+namespace {
+// Shared pool used to decode compressed images of RGBDImage messages
+class DecodeThreadPool
+{
+public:
+	static DecodeThreadPool & instance()
+	{
+		static DecodeThreadPool pool;
+		return pool;
+	}
+
+	std::future<void> post(const std::function<void()> & task)
+	{
+		auto packagedTask = std::make_shared<std::packaged_task<void()> >(task);
+		std::future<void> future = packagedTask->get_future();
+		mutex_.lock();
+		tasks_.push_back([packagedTask](){(*packagedTask)();});
+		mutex_.unlock();
+		condition_.notify_one();
+		return future;
+	}
+
+private:
+	DecodeThreadPool() :
+		stop_(false)
+	{
+		unsigned int threads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+		for(unsigned int i=0; i<threads; ++i)
+		{
+			threads_.push_back(new std::thread(&DecodeThreadPool::mainLoop, this));
+		}
+	}
+	~DecodeThreadPool()
+	{
+		mutex_.lock();
+		stop_ = true;
+		mutex_.unlock();
+		condition_.notify_all();
+		for(size_t i=0; i<threads_.size(); ++i)
+		{
+			threads_[i]->join();
+			delete threads_[i];
+		}
+	}
+
+	void mainLoop()
+	{
+		while(true)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				condition_.wait(lock, [this](){return stop_ || !tasks_.empty();});
+				if(tasks_.empty())
+				{
+					return;
+				}
+				task = tasks_.front();
+				tasks_.pop_front();
+			}
+			task();
+		}
+	}
+
+private:
+	bool stop_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	std::list<std::function<void()> > tasks_;
+	std::vector<std::thread*> threads_;
+};
+
+// Returns a buffer of the calling thread not referenced anymore outside of
+// the pool (e.g. a previous image released by the consumer), so that
+// decoding doesn't need to reallocate when the image size doesn't change.
+cv::Mat * reusableDecodeBuffer()
+{
+	static const size_t maxBuffers = 8;
+	thread_local std::list<cv::Mat> buffers;
+	for(std::list<cv::Mat>::iterator iter=buffers.begin(); iter!=buffers.end(); ++iter)
+	{
+		// refcount is decremented atomically by consumers on other threads
+		if(iter->u == 0 || CV_XADD(&iter->u->refcount, 0) == 1)
+		{
+			return &(*iter);
+		}
+	}
+	if(buffers.size() < maxBuffers)
+	{
+		buffers.push_back(cv::Mat());
+		return &buffers.back();
+	}
+	return 0;
+}
+
+cv_bridge::CvImageConstPtr decodeCompressedImage(const sensor_msgs::msg::CompressedImage & msg)
+{
+	// A format like "rgb8; jpeg compressed bgr8" requires a color
+	// conversion, let cv_bridge handle those
+	std::string format = msg.format;
+	std::string encoding = format.substr(0, format.find(';'));
+	if(format.find(';') != std::string::npos &&
+		encoding.compare(sensor_msgs::image_encodings::BGR8) != 0 &&
+		encoding.compare(sensor_msgs::image_encodings::MONO8) != 0)
+	{
+		return cv_bridge::toCvCopy(msg);
+	}
+
+	cv_bridge::CvImagePtr ptr = std::make_shared<cv_bridge::CvImage>();
+	ptr->header = msg.header;
+	cv::Mat * buffer = reusableDecodeBuffer();
+	if(buffer)
+	{
+		cv::imdecode(cv::Mat(1, msg.data.size(), CV_8UC1, (void*)msg.data.data()), cv::IMREAD_ANYCOLOR, buffer);
+		ptr->image = *buffer;
+	}
+	else
+	{
+		ptr->image = cv::imdecode(cv::Mat(1, msg.data.size(), CV_8UC1, (void*)msg.data.data()), cv::IMREAD_ANYCOLOR);
+	}
+	if(ptr->image.type() == CV_8UC3)
+	{
+		ptr->encoding = sensor_msgs::image_encodings::BGR8;
+	}
+	else if(ptr->image.type() == CV_8UC1)
+	{
+		ptr->encoding = sensor_msgs::image_encodings::MONO8;
+	}
+	else if(!ptr->image.empty())
+	{
+		// unusual format
+		return cv_bridge::toCvCopy(msg);
+	}
+	return ptr;
+}
+
+cv_bridge::CvImageConstPtr decodeCompressedDepth(const sensor_msgs::msg::CompressedImage & msg)
+{
+	if(msg.format.compare("jpg")==0)
+	{
+		// right stereo image
+		return decodeCompressedImage(msg);
+	}
+
+	cv_bridge::CvImagePtr ptr = std::make_shared<cv_bridge::CvImage>();
+	ptr->header = msg.header;
+	cv::Mat * buffer = reusableDecodeBuffer();
+	if(isDepthFormatRVL(msg.format))
+	{
+		ptr->image = uncompressDepthRVL(msg.data, msg.format.compare(kDepthFormatRVLZlib) == 0, buffer);
+	}
+	else if(buffer)
+	{
+		cv::imdecode(cv::Mat(1, msg.data.size(), CV_8UC1, (void*)msg.data.data()), cv::IMREAD_UNCHANGED, buffer);
+		ptr->image = *buffer;
+	}
+	else
+	{
+		ptr->image = cv::imdecode(cv::Mat(1, msg.data.size(), CV_8UC1, (void*)msg.data.data()), cv::IMREAD_UNCHANGED);
+	}
+	if(ptr->image.type() == CV_8UC4)
+	{
+		// float depth is compressed as 4 channels, see rtabmap::compressImage()
+		ptr->image = cv::Mat(ptr->image.size(), CV_32FC1, ptr->image.data).clone();
+	}
+	UASSERT(ptr->image.empty() || ptr->image.type() == CV_32FC1 || ptr->image.type() == CV_16UC1);
+	ptr->encoding = ptr->image.empty()?"":ptr->image.type() == CV_32FC1?sensor_msgs::image_encodings::TYPE_32FC1:sensor_msgs::image_encodings::TYPE_16UC1;
+	return ptr;
+}
+}
+
 void toCvCopy(const rtabmap_ros::msg::RGBDImage & image, cv_bridge::CvImagePtr & rgb, cv_bridge::CvImagePtr & depth)
 {
 	if(!image.rgb.data.empty())
@@ -155,7 +338,14 @@ void toCvCopy(const rtabmap_ros::msg::RGBDImage & image, cv_bridge::CvImagePtr &
 	{
 		cv_bridge::CvImagePtr ptr = std::make_unique<cv_bridge::CvImage>();
 		ptr->header = image.depth_compressed.header;
-		ptr->image = rtabmap::uncompressImage(image.depth_compressed.data);
+		if(isDepthFormatRVL(image.depth_compressed.format))
+		{
+			ptr->image = uncompressDepthRVL(image.depth_compressed.data, image.depth_compressed.format.compare(kDepthFormatRVLZlib) == 0);
+		}
+		else
+		{
+			ptr->image = rtabmap::uncompressImage(image.depth_compressed.data);
+		}
 		UASSERT(ptr->image.empty() || ptr->image.type() == CV_32FC1 || ptr->image.type() == CV_16UC1);
 		ptr->encoding = ptr->image.empty()?"":ptr->image.type() == CV_32FC1?sensor_msgs::image_encodings::TYPE_32FC1:sensor_msgs::image_encodings::TYPE_16UC1;
 		depth = ptr;
@@ -169,44 +359,95 @@ void toCvCopy(const rtabmap_ros::msg::RGBDImage & image, cv_bridge::CvImagePtr &
 
 void toCvShare(const rtabmap_ros::msg::RGBDImage::ConstSharedPtr & image, cv_bridge::CvImageConstPtr & rgb, cv_bridge::CvImageConstPtr & depth)
 {
-	if(!image->rgb.data.empty())
-	{
-		rgb = cv_bridge::toCvShare(image->rgb, image);
-	}
-	else if(!image->rgb_compressed.data.empty())
+	std::vector<cv_bridge::CvImageConstPtr> rgbs(1);
+	std::vector<cv_bridge::CvImageConstPtr> depths(1);
+	toCvShare(std::vector<rtabmap_ros::msg::RGBDImage::ConstSharedPtr>(1, image), rgbs, depths);
+	rgb = rgbs[0];
+	depth = depths[0];
+}
+
+void toCvShare(
+		const std::vector<rtabmap_ros::msg::RGBDImage::ConstSharedPtr> & images,
+		std::vector<cv_bridge::CvImageConstPtr> & rgb,
+		std::vector<cv_bridge::CvImageConstPtr> & depth)
+{
+	rgb.resize(images.size());
+	depth.resize(images.size());
+
+	// Raw images are shared, compressed images are decoded
+	std::vector<std::function<void()> > decodeTasks;
+	for(size_t i=0; i<images.size(); ++i)
 	{
-		rgb = cv_bridge::toCvCopy(image->rgb_compressed);
+		const rtabmap_ros::msg::RGBDImage::ConstSharedPtr & image = images[i];
+		if(!image->rgb.data.empty())
+		{
+			rgb[i] = cv_bridge::toCvShare(image->rgb, image);
+		}
+		else if(!image->rgb_compressed.data.empty())
+		{
+			cv_bridge::CvImageConstPtr & output = rgb[i];
+			decodeTasks.push_back([&output, &image](){output = decodeCompressedImage(image->rgb_compressed);});
+		}
+		else
+		{
+			// empty
+			rgb[i] = std::make_shared<cv_bridge::CvImage>();
+		}
+
+		if(!image->depth.data.empty())
+		{
+			depth[i] = cv_bridge::toCvShare(image->depth, image);
+		}
+		else if(!image->depth_compressed.data.empty())
+		{
+			cv_bridge::CvImageConstPtr & output = depth[i];
+			decodeTasks.push_back([&output, &image](){output = decodeCompressedDepth(image->depth_compressed);});
+		}
+		else
+		{
+			// empty
+			depth[i] = std::make_shared<cv_bridge::CvImage>();
+		}
 	}
-	else
+
+	// Dispatch all decodes but the first one to the pool, the first one is
+	// done on the calling thread while waiting for the others.
+	std::vector<std::future<void> > futures;
+	for(size_t i=1; i<decodeTasks.size(); ++i)
 	{
-		// empty
-		rgb = std::make_shared<cv_bridge::CvImage>();
+		futures.push_back(DecodeThreadPool::instance().post(decodeTasks[i]));
 	}
-
-	if(!image->depth.data.empty())
+	// Tasks write in rgb and depth, so all of them must be finished
+	// before an error is propagated to the caller.
+	std::exception_ptr error;
+	if(!decodeTasks.empty())
 	{
-		depth = cv_bridge::toCvShare(image->depth, image);
+		try
+		{
+			decodeTasks[0]();
+		}
+		catch(...)
+		{
+			error = std::current_exception();
+		}
 	}
-	else if(!image->depth_compressed.data.empty())
+	for(size_t i=0; i<futures.size(); ++i)
 	{
-		if(image->depth_compressed.format.compare("jpg")==0)
+		try
 		{
-			depth = cv_bridge::toCvCopy(image->depth_compressed);
+			futures[i].get();
 		}
-		else
+		catch(...)
 		{
-			cv_bridge::CvImagePtr ptr = std::make_shared<cv_bridge::CvImage>();
-			ptr->header = image->depth_compressed.header;
-			ptr->image = rtabmap::uncompressImage(image->depth_compressed.data);
-			UASSERT(ptr->image.empty() || ptr->image.type() == CV_32FC1 || ptr->image.type() == CV_16UC1);
-			ptr->encoding = ptr->image.empty()?"":ptr->image.type() == CV_32FC1?sensor_msgs::image_encodings::TYPE_32FC1:sensor_msgs::image_encodings::TYPE_16UC1;
-			depth = ptr;
+			if(!error)
+			{
+				error = std::current_exception();
+			}
 		}
 	}
-	else
+	if(error)
 	{
-		// empty
-		depth = std::make_shared<cv_bridge::CvImage>();
+		std::rethrow_exception(error);
 	}
 }
 
@@ -424,34 +665,84 @@ void infoFromROS(const rtabmap_ros::msg::Info & info, rtabmap::Statistics & stat
 	}
 }
 
-void infoToROS(const rtabmap::Statistics & stats, rtabmap_ros::msg::Info & info)
+void infoToROS(const rtabmap::Statistics & stats, rtabmap_ros::msg::Info & info, int groups)
+{
+	infoToROS(stats, std::vector<std::pair<rtabmap_ros::msg::Info*, int> >(1, std::make_pair(&info, groups)));
+}
+
+void infoToROS(const rtabmap::Statistics & stats, const std::vector<std::pair<rtabmap_ros::msg::Info*, int> > & infos)
 {
-	info.ref_id = stats.refImageId();
-	info.loop_closure_id = stats.loopClosureId();
-	info.proximity_detection_id = stats.proximityDetectionId();
+	// posterior, likelihood and raw likelihood are converted only once
+	const rtabmap_ros::msg::Info * loopClosureInfo = 0;
+	for(size_t i=0; i<infos.size(); ++i)
+	{
+		rtabmap_ros::msg::Info & info = *infos[i].first;
+		int groups = infos[i].second;
+		info.ref_id = stats.refImageId();
+		info.loop_closure_id = stats.loopClosureId();
+		info.proximity_detection_id = stats.proximityDetectionId();
 
-	rtabmap_ros::transformToGeometryMsg(stats.loopClosureTransform(), info.loop_closure_transform);
+		rtabmap_ros::transformToGeometryMsg(stats.loopClosureTransform(), info.loop_closure_transform);
+
+		// Detailed info
+		if(!stats.extended())
+		{
+			continue;
+		}
+		if(groups & kInfoLoopClosure)
+		{
+			if(loopClosureInfo)
+			{
+				info.posterior_keys = loopClosureInfo->posterior_keys;
+				info.posterior_values = loopClosureInfo->posterior_values;
+				info.likelihood_keys = loopClosureInfo->likelihood_keys;
+				info.likelihood_values = loopClosureInfo->likelihood_values;
+				info.raw_likelihood_keys = loopClosureInfo->raw_likelihood_keys;
+				info.raw_likelihood_values = loopClosureInfo->raw_likelihood_values;
+			}
+			else
+			{
+				info.posterior_keys = uKeys(stats.posterior());
+				info.posterior_values = uValues(stats.posterior());
+				info.likelihood_keys = uKeys(stats.likelihood());
+				info.likelihood_values = uValues(stats.likelihood());
+				info.raw_likelihood_keys = uKeys(stats.rawLikelihood());
+				info.raw_likelihood_values = uValues(stats.rawLikelihood());
+				loopClosureInfo = &info;
+			}
+		}
+		if(groups == kInfoFull)
+		{
+			info.weights_keys = uKeys(stats.weights());
+			info.weights_values = uValues(stats.weights());
+			info.labels_keys = uKeys(stats.labels());
+			info.labels_values = uValues(stats.labels());
+			info.local_path = stats.localPath();
+			info.current_goal_id = stats.currentGoalId();
+			info.stats_keys.reserve(stats.data().size());
+			info.stats_values.reserve(stats.data().size());
+		}
+	}
 
-	// Detailed info
+	// Statistics data of the selected groups, in one pass for all messages
 	if(stats.extended())
 	{
-		//Posterior, likelihood, childCount
-		info.posterior_keys = uKeys(stats.posterior());
-		info.posterior_values = uValues(stats.posterior());
-		info.likelihood_keys = uKeys(stats.likelihood());
-		info.likelihood_values = uValues(stats.likelihood());
-		info.raw_likelihood_keys = uKeys(stats.rawLikelihood());
-		info.raw_likelihood_values = uValues(stats.rawLikelihood());
-		info.weights_keys = uKeys(stats.weights());
-		info.weights_values = uValues(stats.weights());
-		info.labels_keys = uKeys(stats.labels());
-		info.labels_values = uValues(stats.labels());
-		info.local_path = stats.localPath();
-		info.current_goal_id = stats.currentGoalId();
-
-		// Statistics data
-		info.stats_keys = uKeys(stats.data());
-		info.stats_values = uValues(stats.data());
+		for(std::map<std::string, float>::const_iterator iter=stats.data().begin(); iter!=stats.data().end(); ++iter)
+		{
+			bool timing = iter->first.compare(0, 7, "Timing/") == 0;
+			bool loopClosure = !timing && iter->first.compare(0, 5, "Loop/") == 0;
+			for(size_t i=0; i<infos.size(); ++i)
+			{
+				int groups = infos[i].second;
+				if(groups == kInfoFull ||
+				   ((groups & kInfoTimings) && timing) ||
+				   ((groups & kInfoLoopClosure) && loopClosure))
+				{
+					infos[i].first->stats_keys.push_back(iter->first);
+					infos[i].first->stats_values.push_back(iter->second);
+				}
+			}
+		}
 	}
 }
 
@@ -752,7 +1043,8 @@ void mapDataToROS(
 		const std::multimap<int, rtabmap::Link> & links,
 		const std::map<int, rtabmap::Signature> & signatures,
 		const rtabmap::Transform & map_to_odom,
-		rtabmap_ros::msg::MapData & msg)
+		rtabmap_ros::msg::MapData & msg,
+		NodeDataCache * cache)
 {
 	//Optimized graph
 	mapGraphToROS(poses, links, map_to_odom, msg.graph);
@@ -764,7 +1056,14 @@ void mapDataToROS(
 		iter!=signatures.end();
 		++iter)
 	{
-		nodeDataToROS(iter->second, msg.nodes[index++]);
+		if(cache)
+		{
+			cache->toROS(iter->second, msg.nodes[index++]);
+		}
+		else
+		{
+			nodeDataToROS(iter->second, msg.nodes[index++]);
+		}
 	}
 }
 
@@ -818,6 +1117,179 @@ void mapGraphToROS(
 	transformToGeometryMsg(map_to_odom, msg.map_to_odom);
 }
 
+MapGraphDeltaEncoder::MapGraphDeltaEncoder(int keyframeInterval) :
+	keyframeInterval_(keyframeInterval),
+	sequence_(0),
+	sinceKeyframe_(0)
+{
+}
+
+void MapGraphDeltaEncoder::reset()
+{
+	sinceKeyframe_ = 0;
+	poses_.clear();
+	links_.clear();
+}
+
+void MapGraphDeltaEncoder::encode(
+		const std::map<int, rtabmap::Transform> & poses,
+		const std::multimap<int, rtabmap::Link> & links,
+		const rtabmap::Transform & mapToOdom,
+		rtabmap_ros::msg::MapGraph & msg)
+{
+	// Several links can have the same nodes, use the type too
+	std::map<std::tuple<int, int, int>, rtabmap::Link> linksByIds;
+	for(std::multimap<int, rtabmap::Link>::const_iterator iter=links.begin(); iter!=links.end(); ++iter)
+	{
+		linksByIds.insert(std::make_pair(std::make_tuple(iter->second.from(), iter->second.to(), (int)iter->second.type()), iter->second));
+	}
+
+	// sequence 0 is reserved for messages not part of a stream
+	if(++sequence_ == 0)
+	{
+		++sequence_;
+	}
+	msg.sequence = sequence_;
+	msg.removed_poses_id.clear();
+	msg.removed_links_from.clear();
+	msg.removed_links_to.clear();
+	msg.removed_links_type.clear();
+
+	if(keyframeInterval_ <= 0 || sinceKeyframe_ == 0 || sinceKeyframe_ >= keyframeInterval_)
+	{
+		mapGraphToROS(poses, links, mapToOdom, msg);
+		msg.is_delta = false;
+		sinceKeyframe_ = 1;
+	}
+	else
+	{
+		std::map<int, rtabmap::Transform> changedPoses;
+		for(std::map<int, rtabmap::Transform>::const_iterator iter=poses.begin(); iter!=poses.end(); ++iter)
+		{
+			std::map<int, rtabmap::Transform>::const_iterator jter = poses_.find(iter->first);
+			if(jter == poses_.end() ||
+			   iter->second.isNull() != jter->second.isNull() ||
+			   (!iter->second.isNull() && memcmp(iter->second.data(), jter->second.data(), 12*sizeof(float)) != 0))
+			{
+				changedPoses.insert(*iter);
+			}
+		}
+		std::multimap<int, rtabmap::Link> changedLinks;
+		for(std::map<std::tuple<int, int, int>, rtabmap::Link>::const_iterator iter=linksByIds.begin(); iter!=linksByIds.end(); ++iter)
+		{
+			std::map<std::tuple<int, int, int>, rtabmap::Link>::const_iterator jter = links_.find(iter->first);
+			if(jter == links_.end() ||
+			   memcmp(iter->second.transform().data(), jter->second.transform().data(), 12*sizeof(float)) != 0 ||
+			   iter->second.infMatrix().total() != jter->second.infMatrix().total() ||
+			   memcmp(iter->second.infMatrix().data, jter->second.infMatrix().data, iter->second.infMatrix().total()*iter->second.infMatrix().elemSize()) != 0)
+			{
+				changedLinks.insert(std::make_pair(iter->second.from(), iter->second));
+			}
+		}
+
+		mapGraphToROS(changedPoses, changedLinks, mapToOdom, msg);
+		msg.is_delta = true;
+		for(std::map<int, rtabmap::Transform>::const_iterator iter=poses_.begin(); iter!=poses_.end(); ++iter)
+		{
+			if(poses.find(iter->first) == poses.end())
+			{
+				msg.removed_poses_id.push_back(iter->first);
+			}
+		}
+		for(std::map<std::tuple<int, int, int>, rtabmap::Link>::const_iterator iter=links_.begin(); iter!=links_.end(); ++iter)
+		{
+			if(linksByIds.find(iter->first) == linksByIds.end())
+			{
+				msg.removed_links_from.push_back(std::get<0>(iter->first));
+				msg.removed_links_to.push_back(std::get<1>(iter->first));
+				msg.removed_links_type.push_back(std::get<2>(iter->first));
+			}
+		}
+		++sinceKeyframe_;
+	}
+
+	poses_ = poses;
+	links_ = linksByIds;
+}
+
+MapGraphDeltaDecoder::MapGraphDeltaDecoder() :
+	valid_(false),
+	sequence_(0)
+{
+}
+
+void MapGraphDeltaDecoder::reset()
+{
+	valid_ = false;
+	sequence_ = 0;
+	poses_.clear();
+	links_.clear();
+}
+
+bool MapGraphDeltaDecoder::decode(
+		const rtabmap_ros::msg::MapGraph & msg,
+		std::map<int, rtabmap::Transform> & poses,
+		std::multimap<int, rtabmap::Link> & links,
+		rtabmap::Transform & mapToOdom)
+{
+	UASSERT(msg.poses_id.size() == msg.poses.size());
+	UASSERT(msg.removed_links_from.size() == msg.removed_links_to.size());
+	UASSERT(msg.removed_links_from.size() == msg.removed_links_type.size());
+
+	if(!msg.is_delta && msg.sequence == 0)
+	{
+		// A full graph not part of a stream (e.g., a service response)
+		// doesn't change the state of the stream.
+		mapGraphFromROS(msg, poses, links, mapToOdom);
+		return true;
+	}
+
+	if(!msg.is_delta)
+	{
+		poses_.clear();
+		links_.clear();
+		valid_ = true;
+	}
+	else if(!valid_ || msg.sequence != sequence_+1)
+	{
+		if(valid_)
+		{
+			UWARN("Missed MapGraph delta message(s) (received sequence %d, expected %d), "
+				  "waiting for the next full graph.", (int)msg.sequence, (int)sequence_+1);
+		}
+		valid_ = false;
+		sequence_ = msg.sequence;
+		return false;
+	}
+	sequence_ = msg.sequence;
+
+	for(size_t i=0; i<msg.removed_poses_id.size(); ++i)
+	{
+		poses_.erase(msg.removed_poses_id[i]);
+	}
+	for(size_t i=0; i<msg.removed_links_from.size(); ++i)
+	{
+		links_.erase(std::make_tuple(msg.removed_links_from[i], msg.removed_links_to[i], msg.removed_links_type[i]));
+	}
+	for(size_t i=0; i<msg.poses_id.size(); ++i)
+	{
+		uInsert(poses_, std::make_pair(msg.poses_id[i], transformFromPoseMsg(msg.poses[i])));
+	}
+	for(size_t i=0; i<msg.links.size(); ++i)
+	{
+		uInsert(links_, std::make_pair(std::make_tuple(msg.links[i].from_id, msg.links[i].to_id, msg.links[i].type), linkFromROS(msg.links[i])));
+	}
+
+	poses = poses_;
+	links.clear();
+	for(std::map<std::tuple<int, int, int>, rtabmap::Link>::const_iterator iter=links_.begin(); iter!=links_.end(); ++iter)
+	{
+		links.insert(std::make_pair(iter->second.from(), iter->second));
+	}
+	mapToOdom = transformFromGeometryMsg(msg.map_to_odom);
+	return true;
+}
+
 rtabmap::Signature nodeDataFromROS(const rtabmap_ros::msg::NodeData & msg)
 {
 	//Features stuff...
@@ -1389,6 +1861,167 @@ rtabmap::Transform getTransform(
 	return transform;
 }
 
+cv::Mat ImageBufferPool::acquire(int rows, int cols, int type)
+{
+	mutex_.lock();
+	for(std::list<cv::Mat>::iterator iter=buffers_.begin(); iter!=buffers_.end(); ++iter)
+	{
+		// only referenced by the pool?
+		if(iter->rows == rows && iter->cols == cols && iter->type() == type && iter->u && CV_XADD(&iter->u->refcount, 0) == 1)
+		{
+			cv::Mat buffer = *iter;
+			mutex_.unlock();
+			return buffer;
+		}
+	}
+	cv::Mat buffer(rows, cols, type);
+	buffers_.push_back(buffer);
+	if(buffers_.size() > maxSize_)
+	{
+		buffers_.pop_front();
+	}
+	mutex_.unlock();
+	return buffer;
+}
+
+void ImageBufferPool::clear()
+{
+	mutex_.lock();
+	buffers_.clear();
+	mutex_.unlock();
+}
+
+PointCloud2Writer::PointCloud2Writer(sensor_msgs::msg::PointCloud2 & msg, size_t size, bool rgb, bool normals) :
+		msg_(msg),
+		normalsOffset_(rgb?16:12)
+{
+	std::vector<std::string> names;
+	names.push_back("x");
+	names.push_back("y");
+	names.push_back("z");
+	if(rgb)
+	{
+		names.push_back("rgb");
+	}
+	if(normals)
+	{
+		names.push_back("normal_x");
+		names.push_back("normal_y");
+		names.push_back("normal_z");
+	}
+	msg_.fields.resize(names.size());
+	for(unsigned int i=0; i<msg_.fields.size(); ++i)
+	{
+		msg_.fields[i].name = names[i];
+		msg_.fields[i].offset = i*4;
+		msg_.fields[i].datatype = sensor_msgs::msg::PointField::FLOAT32;
+		msg_.fields[i].count = 1;
+	}
+	msg_.height = 1;
+	msg_.width = size;
+	msg_.is_bigendian = false;
+	msg_.is_dense = true;
+	msg_.point_step = msg_.fields.size()*4;
+	msg_.row_step = msg_.width * msg_.point_step;
+	msg_.data.resize(msg_.row_step);
+}
+
+void points3fToROS(
+		const std::vector<cv::Point3f> & points,
+		sensor_msgs::msg::PointCloud2 & msg,
+		const rtabmap::Transform & transform)
+{
+	PointCloud2Writer writer(msg, points.size());
+	if(transform.isNull() || transform.isIdentity())
+	{
+		for(size_t i=0; i<points.size(); ++i)
+		{
+			writer.set(i, points[i].x, points[i].y, points[i].z);
+		}
+	}
+	else
+	{
+		Eigen::Affine3f t = transform.toEigen3f();
+		for(size_t i=0; i<points.size(); ++i)
+		{
+			Eigen::Vector3f pt = t * Eigen::Vector3f(points[i].x, points[i].y, points[i].z);
+			writer.set(i, pt[0], pt[1], pt[2]);
+		}
+	}
+}
+
+void laserScanToROS(
+		const rtabmap::LaserScan & scan,
+		sensor_msgs::msg::PointCloud2 & msg,
+		const rtabmap::Transform & transform)
+{
+	int normalsOffset = scan.getNormalsOffset();
+	PointCloud2Writer writer(msg, scan.size(), false, normalsOffset >= 0);
+	bool identity = transform.isNull() || transform.isIdentity();
+	Eigen::Affine3f t = identity?Eigen::Affine3f::Identity():transform.toEigen3f();
+	for(int i=0; i<scan.size(); ++i)
+	{
+		const float * ptr = scan.data().ptr<float>(0, i);
+		Eigen::Vector3f pt(ptr[0], ptr[1], scan.is2d()?0.0f:ptr[2]);
+		if(!identity)
+		{
+			pt = t * pt;
+		}
+		writer.set(i, pt[0], pt[1], pt[2]);
+		if(normalsOffset >= 0)
+		{
+			Eigen::Vector3f n(ptr[normalsOffset], ptr[normalsOffset+1], ptr[normalsOffset+2]);
+			if(!identity)
+			{
+				n = t.linear() * n;
+			}
+			writer.setNormal(i, n[0], n[1], n[2]);
+		}
+	}
+}
+
+void cvtColorTo(
+		const cv_bridge::CvImageConstPtr & image,
+		const std::string & encoding,
+		cv::Mat & dst)
+{
+	UASSERT(image.get() && dst.rows == image->image.rows && dst.cols == image->image.cols);
+	const std::string & src = image->encoding;
+	int code = -1;
+	if(src.compare(encoding) == 0 ||
+	   (src.compare(sensor_msgs::image_encodings::TYPE_8UC1) == 0 && encoding.compare(sensor_msgs::image_encodings::MONO8) == 0))
+	{
+		image->image.copyTo(dst);
+		return;
+	}
+	else if(encoding.compare(sensor_msgs::image_encodings::BGR8) == 0)
+	{
+		code = src.compare(sensor_msgs::image_encodings::RGB8) == 0?cv::COLOR_RGB2BGR:
+			   src.compare(sensor_msgs::image_encodings::BGRA8) == 0?cv::COLOR_BGRA2BGR:
+			   src.compare(sensor_msgs::image_encodings::RGBA8) == 0?cv::COLOR_RGBA2BGR:
+			   src.compare(sensor_msgs::image_encodings::MONO8) == 0?cv::COLOR_GRAY2BGR:-1;
+	}
+	else if(encoding.compare(sensor_msgs::image_encodings::MONO8) == 0)
+	{
+		code = src.compare(sensor_msgs::image_encodings::BGR8) == 0?cv::COLOR_BGR2GRAY:
+			   src.compare(sensor_msgs::image_encodings::RGB8) == 0?cv::COLOR_RGB2GRAY:
+			   src.compare(sensor_msgs::image_encodings::BGRA8) == 0?cv::COLOR_BGRA2GRAY:
+			   src.compare(sensor_msgs::image_encodings::RGBA8) == 0?cv::COLOR_RGBA2GRAY:-1;
+	}
+
+	if(code >= 0)
+	{
+		// dst already has the right size and type, so it is written in place
+		cv::cvtColor(image->image, dst, code);
+	}
+	else
+	{
+		// other conversions (bayer, mono16...)
+		cv_bridge::cvtColor(image, encoding)->image.copyTo(dst);
+	}
+	UASSERT(dst.data);
+}
+
 bool convertRGBDMsgs(
 		const std::vector<cv_bridge::CvImageConstPtr> & imageMsgs,
 		const std::vector<cv_bridge::CvImageConstPtr> & depthMsgs,
@@ -1400,7 +2033,8 @@ bool convertRGBDMsgs(
 		cv::Mat & depth,
 		std::vector<rtabmap::CameraModel> & cameraModels,
 		tf2_ros::Buffer & listener,
-		double waitForTransform)
+		double waitForTransform,
+		ImageBufferPool * pool)
 {
 	UASSERT(imageMsgs.size()>0 &&
 			(imageMsgs.size() == depthMsgs.size() || depthMsgs.empty()) &&
@@ -1497,30 +2131,22 @@ bool convertRGBDMsgs(
 			}
 		}
 
-		cv_bridge::CvImageConstPtr ptrImage = imageMsgs[i];
-		if(imageMsgs[i]->encoding.compare(sensor_msgs::image_encodings::TYPE_8UC1)==0 ||
-		   imageMsgs[i]->encoding.compare(sensor_msgs::image_encodings::MONO8) == 0 ||
-		   imageMsgs[i]->encoding.compare(sensor_msgs::image_encodings::BGR8) == 0)
-		{
-			// do nothing
-		}
-		else if(imageMsgs[i]->encoding.compare(sensor_msgs::image_encodings::MONO16) == 0)
-		{
-			ptrImage = cv_bridge::cvtColor(imageMsgs[i], "mono8");
-		}
-		else
-		{
-			ptrImage = cv_bridge::cvtColor(imageMsgs[i], "bgr8");
-		}
+		// mono images stay mono, other color images are converted to bgr
+		std::string encoding = imageMsgs[i]->encoding.compare(sensor_msgs::image_encodings::TYPE_8UC1)==0 ||
+			imageMsgs[i]->encoding.compare(sensor_msgs::image_encodings::MONO8) == 0 ||
+			imageMsgs[i]->encoding.compare(sensor_msgs::image_encodings::MONO16) == 0?
+					sensor_msgs::image_encodings::MONO8:sensor_msgs::image_encodings::BGR8;
+		int type = encoding.compare(sensor_msgs::image_encodings::MONO8) == 0?CV_8UC1:CV_8UC3;
 
 		// initialize
 		if(rgb.empty())
 		{
-			rgb = cv::Mat(imageHeight, imageWidth*cameraCount, ptrImage->image.type());
+			rgb = pool?pool->acquire(imageHeight, imageWidth*cameraCount, type):cv::Mat(imageHeight, imageWidth*cameraCount, type);
 		}
-		if(ptrImage->image.type() == rgb.type())
+		if(type == rgb.type())
 		{
-			ptrImage->image.copyTo(cv::Mat(rgb, cv::Rect(i*imageWidth, 0, imageWidth, imageHeight)));
+			cv::Mat roi(rgb, cv::Rect(i*imageWidth, 0, imageWidth, imageHeight));
+			cvtColorTo(imageMsgs[i], encoding, roi);
 		}
 		else
 		{
@@ -1530,12 +2156,11 @@ bool convertRGBDMsgs(
 
 		if(depthMsgs.size())
 		{
-			cv_bridge::CvImageConstPtr ptrDepth = depthMsgs[i];
-			cv::Mat subDepth = ptrDepth->image;
+			const cv::Mat & subDepth = depthMsgs[i]->image;
 
 			if(depth.empty())
 			{
-				depth = cv::Mat(depthHeight, depthWidth*cameraCount, subDepth.type());
+				depth = pool?pool->acquire(depthHeight, depthWidth*cameraCount, subDepth.type()):cv::Mat(depthHeight, depthWidth*cameraCount, subDepth.type());
 			}
 
 			if(subDepth.type() == depth.type())
@@ -1775,6 +2400,148 @@ bool convertScanMsg(
 	return true;
 }
 
+namespace {
+float readPointField(const uint8_t * ptr, uint8_t datatype)
+{
+	switch(datatype)
+	{
+	case sensor_msgs::msg::PointField::FLOAT32: {float v; memcpy(&v, ptr, 4); return v;}
+	case sensor_msgs::msg::PointField::FLOAT64: {double v; memcpy(&v, ptr, 8); return (float)v;}
+	case sensor_msgs::msg::PointField::INT8: return (float)*(const int8_t*)ptr;
+	case sensor_msgs::msg::PointField::UINT8: return (float)*ptr;
+	case sensor_msgs::msg::PointField::INT16: {int16_t v; memcpy(&v, ptr, 2); return (float)v;}
+	case sensor_msgs::msg::PointField::UINT16: {uint16_t v; memcpy(&v, ptr, 2); return (float)v;}
+	case sensor_msgs::msg::PointField::INT32: {int32_t v; memcpy(&v, ptr, 4); return (float)v;}
+	case sensor_msgs::msg::PointField::UINT32: {uint32_t v; memcpy(&v, ptr, 4); return (float)v;}
+	}
+	return 0.0f;
+}
+}
+
+bool laserScanFromPointCloud2(
+		const sensor_msgs::msg::PointCloud2 & msg,
+		rtabmap::LaserScan & scan,
+		const rtabmap::Transform & localTransform,
+		int maxPoints,
+		float maxRange,
+		float rangeMin,
+		float rangeMax,
+		int downsamplingStep)
+{
+	const sensor_msgs::msg::PointField * fx=0, * fy=0, * fz=0, * fi=0, * frgb=0, * fnx=0, * fny=0, * fnz=0;
+	for(unsigned int i=0; i<msg.fields.size(); ++i)
+	{
+		const sensor_msgs::msg::PointField & f = msg.fields[i];
+		if(f.name.compare("x") == 0) fx = &f;
+		else if(f.name.compare("y") == 0) fy = &f;
+		else if(f.name.compare("z") == 0) fz = &f;
+		else if(f.name.compare("intensity") == 0) fi = &f;
+		else if(f.name.compare("rgb") == 0 || f.name.compare("rgba") == 0) frgb = &f;
+		else if(f.name.compare("normal_x") == 0) fnx = &f;
+		else if(f.name.compare("normal_y") == 0) fny = &f;
+		else if(f.name.compare("normal_z") == 0) fnz = &f;
+	}
+	if(fx == 0 || fy == 0 || fz == 0 ||
+	   fx->datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+	   fy->datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+	   fz->datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+	   msg.is_bigendian)
+	{
+		return false;
+	}
+	bool normals = fnx && fny && fnz;
+	if(frgb && frgb->datatype != sensor_msgs::msg::PointField::FLOAT32 && frgb->datatype != sensor_msgs::msg::PointField::UINT32)
+	{
+		frgb = 0;
+	}
+	if(frgb)
+	{
+		fi = 0; // same as pcl conversion, color has priority on intensity
+	}
+
+	rtabmap::LaserScan::Format format;
+	if(frgb)
+	{
+		format = normals?rtabmap::LaserScan::kXYZRGBNormal:rtabmap::LaserScan::kXYZRGB;
+	}
+	else if(fi)
+	{
+		format = normals?rtabmap::LaserScan::kXYZINormal:rtabmap::LaserScan::kXYZI;
+	}
+	else
+	{
+		format = normals?rtabmap::LaserScan::kXYZNormal:rtabmap::LaserScan::kXYZ;
+	}
+	int channels = rtabmap::LaserScan::channels(format);
+	int normalOffset = channels-3;
+
+	int step = downsamplingStep>1?downsamplingStep:1;
+	size_t total = (size_t)msg.width * msg.height;
+	cv::Mat data(1, (total+step-1)/step, CV_32FC(channels));
+	float * out = data.ptr<float>();
+	float rangeMinSqr = rangeMin*rangeMin;
+	float rangeMaxSqr = rangeMax*rangeMax;
+	int n = 0;
+	for(size_t i=0; i<total; i+=step)
+	{
+		const uint8_t * ptr = msg.data.data() + (i/msg.width)*msg.row_step + (i%msg.width)*msg.point_step;
+		float x,y,z;
+		memcpy(&x, ptr+fx->offset, 4);
+		memcpy(&y, ptr+fy->offset, 4);
+		memcpy(&z, ptr+fz->offset, 4);
+		if(!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
+		{
+			continue;
+		}
+		if(rangeMin > 0.0f || rangeMax > 0.0f)
+		{
+			float d = x*x + y*y + z*z;
+			if((rangeMin > 0.0f && d < rangeMinSqr) || (rangeMax > 0.0f && d > rangeMaxSqr))
+			{
+				continue;
+			}
+		}
+		float * pt = out + n*channels;
+		if(normals)
+		{
+			pt[normalOffset] = readPointField(ptr+fnx->offset, fnx->datatype);
+			pt[normalOffset+1] = readPointField(ptr+fny->offset, fny->datatype);
+			pt[normalOffset+2] = readPointField(ptr+fnz->offset, fnz->datatype);
+			if(!std::isfinite(pt[normalOffset]) || !std::isfinite(pt[normalOffset+1]) || !std::isfinite(pt[normalOffset+2]))
+			{
+				continue;
+			}
+		}
+		pt[0] = x;
+		pt[1] = y;
+		pt[2] = z;
+		if(frgb)
+		{
+			memcpy(pt+3, ptr+frgb->offset, 4); // packed rgb
+		}
+		else if(fi)
+		{
+			pt[3] = readPointField(ptr+fi->offset, fi->datatype);
+		}
+		++n;
+	}
+
+	if(n == 0)
+	{
+		data = cv::Mat();
+	}
+	else if(n < data.cols/2)
+	{
+		data = data.colRange(0, n).clone(); // release the unused memory
+	}
+	else
+	{
+		data = data.colRange(0, n);
+	}
+	scan = rtabmap::LaserScan(data, maxPoints, maxRange, format, localTransform);
+	return true;
+}
+
 bool convertScan3dMsg(
 		const sensor_msgs::msg::PointCloud2 & scan3dMsg,
 		const std::string & frameId,
@@ -1833,6 +2600,11 @@ bool convertScan3dMsg(
 		}
 	}
 
+	if(laserScanFromPointCloud2(scan3dMsg, scan, scanLocalTransform, maxPoints, maxRange))
+	{
+		return true;
+	}
+
 	if(containNormals)
 	{
 		if(containColors)
@@ -1902,16 +2674,18 @@ bool convertScan3dMsg(
 	return true;
 }
 
+// Transform in place points [begin, end) of the cloud
 void
-transformPointCloud (
+transformPointCloudPoints (
 		const Eigen::Matrix4f &transform,
-		const sensor_msgs::msg::PointCloud2 &in,
-        sensor_msgs::msg::PointCloud2 &out)
+		sensor_msgs::msg::PointCloud2 &cloud,
+		size_t begin,
+		size_t end)
 {
   // Get X-Y-Z indices
-  int x_idx = pcl::getFieldIndex (in, "x");
-  int y_idx = pcl::getFieldIndex (in, "y");
-  int z_idx = pcl::getFieldIndex (in, "z");
+  int x_idx = pcl::getFieldIndex (cloud, "x");
+  int y_idx = pcl::getFieldIndex (cloud, "y");
+  int z_idx = pcl::getFieldIndex (cloud, "z");
 
   if (x_idx == -1 || y_idx == -1 || z_idx == -1)
   {
@@ -1919,94 +2693,145 @@ transformPointCloud (
     return;
   }
 
-  if (in.fields[x_idx].datatype != sensor_msgs::msg::PointField::FLOAT32 ||
-      in.fields[y_idx].datatype != sensor_msgs::msg::PointField::FLOAT32 ||
-      in.fields[z_idx].datatype != sensor_msgs::msg::PointField::FLOAT32)
+  if (cloud.fields[x_idx].datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+      cloud.fields[y_idx].datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+      cloud.fields[z_idx].datatype != sensor_msgs::msg::PointField::FLOAT32)
   {
 	  UERROR ("X-Y-Z coordinates not floats. Currently only floats are supported.");
     return;
   }
 
-  // Check if distance is available
-  int dist_idx = pcl::getFieldIndex (in, "distance");
-
-  // Copy the other data
-  if (&in != &out)
-  {
-    out.header = in.header;
-    out.height = in.height;
-    out.width  = in.width;
-    out.fields = in.fields;
-    out.is_bigendian = in.is_bigendian;
-    out.point_step   = in.point_step;
-    out.row_step     = in.row_step;
-    out.is_dense     = in.is_dense;
-    out.data.resize (in.data.size ());
-    // Copy everything as it's faster than copying individual elements
-    memcpy (&out.data[0], &in.data[0], in.data.size ());
-  }
-
-  Eigen::Array4i xyz_offset (in.fields[x_idx].offset, in.fields[y_idx].offset, in.fields[z_idx].offset, 0);
-
-  for (size_t i = 0; i < in.width * in.height; ++i)
+  UASSERT(begin <= end && end <= (size_t)cloud.width * cloud.height);
+
+  UTimer timer;
+
+  // Check if distance and viewpoint are available
+  int dist_idx = pcl::getFieldIndex (cloud, "distance");
+  int vp_idx = pcl::getFieldIndex (cloud, "vp_x");
+  const int distOffset = dist_idx < 0 ? -1 : (int)cloud.fields[dist_idx].offset;
+  const int vpOffset = vp_idx < 0 ? -1 : (int)cloud.fields[vp_idx].offset;
+
+  const int xOffset = cloud.fields[x_idx].offset;
+  const int yOffset = cloud.fields[y_idx].offset;
+  const int zOffset = cloud.fields[z_idx].offset;
+
+  // Points are gathered (strided layout) in blocks of homogeneous
+  // column vectors, so that transform * block is done with SIMD packets.
+  const int blockSize = 256;
+  Eigen::Matrix<float, 4, blockSize> block;
+  Eigen::Matrix<float, 4, blockSize> vpBlock;
+  Eigen::Matrix<float, 4, blockSize> result; // scratch, products are written without temporary
+  block.row(3).setOnes();
+  vpBlock.row(3).setOnes();
+  size_t offsets[blockSize];
+  unsigned char status[blockSize]; // 0=valid, 1=invalid, 2=max range
+
+  size_t i = begin;
+  while (i < end)
   {
-    Eigen::Vector4f pt (*(float*)&in.data[xyz_offset[0]], *(float*)&in.data[xyz_offset[1]], *(float*)&in.data[xyz_offset[2]], 1);
-    Eigen::Vector4f pt_out;
-
-    bool max_range_point = false;
-    int distance_ptr_offset = i*in.point_step + in.fields[dist_idx].offset;
-    float* distance_ptr = (dist_idx < 0 ? NULL : (float*)(&in.data[distance_ptr_offset]));
-    if (!std::isfinite (pt[0]) || !std::isfinite (pt[1]) || !std::isfinite (pt[2]))
+    int n = 0;
+    for (; n < blockSize && i < end; ++n, ++i)
     {
-      if (distance_ptr==NULL || !std::isfinite(*distance_ptr))  // Invalid point
+      // handle padded rows
+      size_t offset = (i / cloud.width) * cloud.row_step + (i % cloud.width) * cloud.point_step;
+      offsets[n] = offset;
+      unsigned char * ptr = &cloud.data[offset];
+      memcpy (&block(0, n), ptr + xOffset, sizeof (float));
+      memcpy (&block(1, n), ptr + yOffset, sizeof (float));
+      memcpy (&block(2, n), ptr + zOffset, sizeof (float));
+      status[n] = 0;
+      if (!std::isfinite (block(0, n)) || !std::isfinite (block(1, n)) || !std::isfinite (block(2, n)))
       {
-        pt_out = pt;
+        float distance = std::numeric_limits<float>::quiet_NaN();
+        if (distOffset >= 0)
+        {
+          memcpy (&distance, ptr + distOffset, sizeof (float));
+        }
+        if (!std::isfinite (distance))  // Invalid point
+        {
+          status[n] = 1;
+        }
+        else  // max range point
+        {
+          block(0, n) = distance;  // Replace x with the x value saved in distance
+          status[n] = 2;
+        }
       }
-      else  // max range point
+      if (vpOffset >= 0)
       {
-        pt[0] = *distance_ptr;  // Replace x with the x value saved in distance
-        pt_out = transform * pt;
-        max_range_point = true;
-        //std::cout << pt[0]<<","<<pt[1]<<","<<pt[2]<<" => "<<pt_out[0]<<","<<pt_out[1]<<","<<pt_out[2]<<"\n";
+        // Assume vp_x, vp_y, vp_z are consecutive
+        memcpy (&vpBlock(0, n), ptr + vpOffset, 3*sizeof (float));
       }
     }
-    else
-    {
-      pt_out = transform * pt;
-    }
 
-    if (max_range_point)
+    result.leftCols(n).noalias() = transform * block.leftCols(n);
+    block.topLeftCorner(3, n) = result.topLeftCorner(3, n);
+    if (vpOffset >= 0)
     {
-      // Save x value in distance again
-      *(float*)(&out.data[distance_ptr_offset]) = pt_out[0];
-      pt_out[0] = std::numeric_limits<float>::quiet_NaN();
+      result.leftCols(n).noalias() = transform * vpBlock.leftCols(n);
+      vpBlock.topLeftCorner(3, n) = result.topLeftCorner(3, n);
     }
 
-    memcpy (&out.data[xyz_offset[0]], &pt_out[0], sizeof (float));
-    memcpy (&out.data[xyz_offset[1]], &pt_out[1], sizeof (float));
-    memcpy (&out.data[xyz_offset[2]], &pt_out[2], sizeof (float));
-
+    for (int j = 0; j < n; ++j)
+    {
+      unsigned char * ptr = &cloud.data[offsets[j]];
+      if (status[j] == 0)
+      {
+        memcpy (ptr + xOffset, &block(0, j), sizeof (float));
+        memcpy (ptr + yOffset, &block(1, j), sizeof (float));
+        memcpy (ptr + zOffset, &block(2, j), sizeof (float));
+      }
+      else if (status[j] == 2)
+      {
+        // Save x value in distance again
+        memcpy (ptr + distOffset, &block(0, j), sizeof (float));
+        float nan = std::numeric_limits<float>::quiet_NaN();
+        memcpy (ptr + xOffset, &nan, sizeof (float));
+        memcpy (ptr + yOffset, &block(1, j), sizeof (float));
+        memcpy (ptr + zOffset, &block(2, j), sizeof (float));
+      }
+      // invalid points are left untouched
 
-    xyz_offset += in.point_step;
+      if (vpOffset >= 0)
+      {
+        memcpy (ptr + vpOffset, &vpBlock(0, j), 3*sizeof (float));
+      }
+    }
   }
 
-  // Check if the viewpoint information is present
-  int vp_idx = pcl::getFieldIndex (in, "vp_x");
-  if (vp_idx != -1)
+  double elapsed = timer.elapsed();
+  UDEBUG ("Transformed %d points in %f ms (%f Mpts/s)",
+		  (int)(end-begin),
+		  elapsed*1000.0,
+		  elapsed > 0.0 ? double(end-begin)/elapsed/1000000.0 : 0.0);
+}
+
+void
+transformPointCloud (
+		const Eigen::Matrix4f &transform,
+		const sensor_msgs::msg::PointCloud2 &in,
+        sensor_msgs::msg::PointCloud2 &out)
+{
+  // Copy the other data (skipped when transforming in place, out buffer is reused if already allocated)
+  if (&in != &out)
   {
-    // Transform the viewpoint info too
-    for (size_t i = 0; i < out.width * out.height; ++i)
+    out.header = in.header;
+    out.height = in.height;
+    out.width  = in.width;
+    out.fields = in.fields;
+    out.is_bigendian = in.is_bigendian;
+    out.point_step   = in.point_step;
+    out.row_step     = in.row_step;
+    out.is_dense     = in.is_dense;
+    out.data.resize (in.data.size ());
+    // Copy everything as it's faster than copying individual elements
+    if(in.data.size())
     {
-      float *pstep = (float*)&out.data[i * out.point_step + out.fields[vp_idx].offset];
-      // Assume vp_x, vp_y, vp_z are consecutive
-      Eigen::Vector4f vp_in (pstep[0], pstep[1], pstep[2], 1);
-      Eigen::Vector4f vp_out = transform * vp_in;
-
-      pstep[0] = vp_out[0];
-      pstep[1] = vp_out[1];
-      pstep[2] = vp_out[2];
+      memcpy (&out.data[0], &in.data[0], in.data.size ());
     }
   }
+
+  transformPointCloudPoints(transform, out, 0, (size_t)out.width * out.height);
 }
 
 }
@@ -0,0 +1,302 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "rtabmap_ros/NodeDataCache.h"
+#include "rtabmap_ros/MsgConversion.h"
+#include <cstring>
+
+namespace rtabmap_ros {
+
+NodeDataCache::NodeDataCache(unsigned int capacity) :
+	capacity_(capacity),
+	hits_(0),
+	misses_(0)
+{
+}
+
+void NodeDataCache::setCapacity(unsigned int capacity)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	capacity_ = capacity;
+	evict();
+}
+
+unsigned int NodeDataCache::capacity() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return capacity_;
+}
+
+namespace {
+
+// 64 bits hash of the content, 8 bytes at a time
+class Hasher
+{
+public:
+	Hasher() : h_(0xcbf29ce484222325ULL), bytes_(0) {}
+
+	void add(const void * data, size_t size)
+	{
+		const unsigned char * ptr = (const unsigned char *)data;
+		size_t i=0;
+		for(; i+8<=size; i+=8)
+		{
+			unsigned long long v;
+			memcpy(&v, ptr+i, 8);
+			mix(v);
+		}
+		if(i<size)
+		{
+			unsigned long long v = 0;
+			memcpy(&v, ptr+i, size-i);
+			mix(v);
+		}
+		bytes_ += size;
+	}
+	template<typename T>
+	void add(const T & value)
+	{
+		add(&value, sizeof(T));
+	}
+	void add(const cv::Mat & mat)
+	{
+		add(mat.rows);
+		add(mat.cols);
+		add(mat.type());
+		for(int i=0; i<mat.rows; ++i)
+		{
+			add(mat.ptr(i), mat.cols*mat.elemSize());
+		}
+	}
+	void add(const rtabmap::Transform & transform)
+	{
+		add(transform.dataMatrix());
+	}
+	void add(const rtabmap::CameraModel & model)
+	{
+		add(model.fx());
+		add(model.fy());
+		add(model.cx());
+		add(model.cy());
+		add(model.imageWidth());
+		add(model.imageHeight());
+		add(model.localTransform());
+	}
+
+	unsigned long long hash() const {return h_;}
+	unsigned long long bytes() const {return bytes_;}
+
+private:
+	void mix(unsigned long long v)
+	{
+		v *= 0x9e3779b97f4a7c15ULL;
+		v ^= v >> 32;
+		h_ = (h_ ^ v) * 0x100000001b3ULL;
+		h_ ^= h_ >> 29;
+	}
+
+private:
+	unsigned long long h_;
+	unsigned long long bytes_;
+};
+
+}
+
+NodeDataCache::Fingerprint NodeDataCache::fingerprint(const rtabmap::Signature & signature)
+{
+	// Hash of all fields serialized by nodeDataToROS() but not by
+	// nodeInfoToROS(). The content is hashed (not the buffer addresses), so
+	// a node reloaded from the database with the same data is still a hit,
+	// and a new buffer allocated at the same address is not.
+	const rtabmap::SensorData & data = signature.sensorData();
+	Hasher hasher;
+	hasher.add(data.gps().stamp());
+	hasher.add(data.gps().longitude());
+	hasher.add(data.gps().latitude());
+	hasher.add(data.gps().altitude());
+	hasher.add(data.gps().error());
+	hasher.add(data.gps().bearing());
+	hasher.add(data.imageCompressed());
+	hasher.add(data.depthOrRightCompressed());
+	hasher.add(data.laserScanCompressed().data());
+	hasher.add(data.laserScanCompressed().maxPoints());
+	hasher.add(data.laserScanCompressed().rangeMax());
+	hasher.add((int)data.laserScanCompressed().format());
+	hasher.add(data.laserScanCompressed().localTransform());
+	hasher.add(data.userDataCompressed());
+	hasher.add(data.gridGroundCellsCompressed());
+	hasher.add(data.gridObstacleCellsCompressed());
+	hasher.add(data.gridEmptyCellsCompressed());
+	hasher.add(data.gridViewPoint().x);
+	hasher.add(data.gridViewPoint().y);
+	hasher.add(data.gridViewPoint().z);
+	hasher.add(data.gridCellSize());
+	hasher.add(data.cameraModels().size());
+	for(unsigned int i=0; i<data.cameraModels().size(); ++i)
+	{
+		hasher.add(data.cameraModels()[i]);
+	}
+	if(data.cameraModels().empty() && data.stereoCameraModel().isValidForProjection())
+	{
+		hasher.add(data.stereoCameraModel().left());
+		hasher.add(data.stereoCameraModel().baseline());
+	}
+
+	hasher.add(signature.getWords().size());
+	for(std::multimap<int, int>::const_iterator iter=signature.getWords().begin(); iter!=signature.getWords().end(); ++iter)
+	{
+		hasher.add(iter->first);
+	}
+	hasher.add(signature.getWordsKpts().size());
+	for(unsigned int i=0; i<signature.getWordsKpts().size(); ++i)
+	{
+		const cv::KeyPoint & kpt = signature.getWordsKpts()[i];
+		hasher.add(kpt.pt.x);
+		hasher.add(kpt.pt.y);
+		hasher.add(kpt.size);
+		hasher.add(kpt.angle);
+		hasher.add(kpt.response);
+		hasher.add(kpt.octave);
+		hasher.add(kpt.class_id);
+	}
+	hasher.add(signature.getWords3().size());
+	if(signature.getWords3().size())
+	{
+		hasher.add(signature.getWords3().data(), signature.getWords3().size()*sizeof(cv::Point3f));
+	}
+	hasher.add(signature.getWordsDescriptors());
+
+	Fingerprint fp;
+	fp.hash = hasher.hash();
+	fp.bytes = hasher.bytes();
+	return fp;
+}
+
+void NodeDataCache::toROS(const rtabmap::Signature & signature, rtabmap_ros::msg::NodeData & msg)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	if(capacity_ == 0)
+	{
+		lock.unlock();
+		nodeDataToROS(signature, msg);
+		return;
+	}
+
+	Fingerprint fp = fingerprint(signature);
+	std::map<int, Entry>::iterator iter = entries_.find(signature.id());
+	if(iter != entries_.end() && iter->second.fingerprint == fp)
+	{
+		++hits_;
+		lru_.splice(lru_.begin(), lru_, iter->second.lruIter);
+		std::shared_ptr<const rtabmap_ros::msg::NodeData> cached = iter->second.msg;
+		lock.unlock();
+
+		msg = *cached;
+		nodeInfoToROS(signature, msg);
+		return;
+	}
+	++misses_;
+	lock.unlock();
+
+	// Convert outside the lock, other requests can be served meanwhile
+	std::shared_ptr<rtabmap_ros::msg::NodeData> converted(new rtabmap_ros::msg::NodeData);
+	nodeDataToROS(signature, *converted);
+	msg = *converted;
+
+	lock.lock();
+	iter = entries_.find(signature.id());
+	if(iter != entries_.end())
+	{
+		iter->second.fingerprint = fp;
+		iter->second.msg = converted;
+		lru_.splice(lru_.begin(), lru_, iter->second.lruIter);
+	}
+	else
+	{
+		lru_.push_front(signature.id());
+		Entry & entry = entries_[signature.id()];
+		entry.fingerprint = fp;
+		entry.msg = converted;
+		entry.lruIter = lru_.begin();
+		evict();
+	}
+}
+
+void NodeDataCache::remove(int id)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::map<int, Entry>::iterator iter = entries_.find(id);
+	if(iter != entries_.end())
+	{
+		lru_.erase(iter->second.lruIter);
+		entries_.erase(iter);
+	}
+}
+
+void NodeDataCache::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	entries_.clear();
+	lru_.clear();
+	hits_ = 0;
+	misses_ = 0;
+}
+
+unsigned int NodeDataCache::size() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return (unsigned int)entries_.size();
+}
+
+unsigned long long NodeDataCache::hits() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return hits_;
+}
+
+unsigned long long NodeDataCache::misses() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return misses_;
+}
+
+float NodeDataCache::hitRate() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return hits_+misses_>0?float(hits_)/float(hits_+misses_):0.0f;
+}
+
+// mutex_ should be locked
+void NodeDataCache::evict()
+{
+	while(entries_.size() > capacity_)
+	{
+		entries_.erase(lru_.back());
+		lru_.pop_back();
+	}
+}
+
+} /* namespace rtabmap_ros */
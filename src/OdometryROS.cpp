@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <rtabmap/core/util3d_transforms.h>
 #include <rtabmap/core/Memory.h>
 #include <rtabmap/core/Signature.h>
+#include <rtabmap/core/util2d.h>
 #include "rtabmap_ros/MsgConversion.h"
 #include "rtabmap_ros/msg/odom_info.hpp"
 #include "rtabmap/utilite/UConversion.h"
@@ -49,6 +50,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "rtabmap/utilite/UStl.h"
 #include "rtabmap/utilite/UFile.h"
 #include "rtabmap/utilite/UMath.h"
+#include "rtabmap/utilite/UTimer.h"
 
 #define BAD_COVARIANCE 9999
 
@@ -85,8 +87,25 @@ OdometryROS::OdometryROS(const std::string & name, const rclcpp::NodeOptions & o
 	waitIMUToinit_(false),
 	imuProcessed_(false),
 	lastImuReceivedStamp_(0.0),
+	bufferedDataMaxSize_(10),
+	bufferedDataWaitTime_(0.0),
 	configPath_(),
-	initialPose_(Transform::getIdentity())
+	initialPose_(Transform::getIdentity()),
+	latencyTrace_(false),
+	pipelined_(false),
+	pipelineDepthAsMask_(true),
+	pipelineFeature2D_(0),
+	pipelineThread_(0),
+	pipelineBusy_(false),
+	pipelineStop_(false),
+	loadShedding_(false),
+	loadSheddingMaxLag_(0.2),
+	loadSheddingMaxSkips_(4),
+	loadSheddingProcessTime_(0.0),
+	loadSheddingInputPeriod_(0.0),
+	loadSheddingLastInputStamp_(0.0),
+	loadSheddingDecimation_(1),
+	loadSheddingSkipped_(0)
 {
 	odomPub_ = create_publisher<nav_msgs::msg::Odometry>("odom", 1);
 	odomInfoPub_ = create_publisher<rtabmap_ros::msg::OdomInfo>("odom_info", 1);
@@ -120,8 +139,22 @@ OdometryROS::OdometryROS(const std::string & name, const rclcpp::NodeOptions & o
 	guessMinTime_ = this->declare_parameter("guess_min_time", guessMinTime_);
 
 	expectedUpdateRate_ = this->declare_parameter("expected_update_rate", expectedUpdateRate_);
+	pipelined_ = this->declare_parameter("pipelined", pipelined_);
+	loadShedding_ = this->declare_parameter("load_shedding", loadShedding_);
+	loadSheddingMaxLag_ = this->declare_parameter("load_shedding_max_lag", loadSheddingMaxLag_);
+	loadSheddingMaxSkips_ = this->declare_parameter("load_shedding_max_skips", loadSheddingMaxSkips_);
 
 	waitIMUToinit_ = this->declare_parameter("wait_imu_to_init", waitIMUToinit_);
+	bufferedDataMaxSize_ = this->declare_parameter("imu_frame_queue_size", bufferedDataMaxSize_);
+	if(bufferedDataMaxSize_ < 1)
+	{
+		RCLCPP_WARN(this->get_logger(), "imu_frame_queue_size should be >= 1, setting it to 1.");
+		bufferedDataMaxSize_ = 1;
+	}
+
+	latencyTrace_ = this->declare_parameter("latency_trace", latencyTrace_);
+	int latencyTraceSize = this->declare_parameter("latency_trace_size", 1000);
+	latencyTraceFile_ = this->declare_parameter("latency_trace_file", latencyTraceFile_);
 
 	if(publishTf_ && !guessFrameId_.empty() && guessFrameId_.compare(odomFrameId_) == 0)
 	{
@@ -144,7 +177,24 @@ OdometryROS::OdometryROS(const std::string & name, const rclcpp::NodeOptions & o
 	RCLCPP_INFO(this->get_logger(), "Odometry: guess_min_rotation     = %f", guessMinRotation_);
 	RCLCPP_INFO(this->get_logger(), "Odometry: guess_min_time         = %f", guessMinTime_);
 	RCLCPP_INFO(this->get_logger(), "Odometry: expected_update_rate   = %f Hz", expectedUpdateRate_);
+	RCLCPP_INFO(this->get_logger(), "Odometry: pipelined              = %s", pipelined_?"true":"false");
+	RCLCPP_INFO(this->get_logger(), "Odometry: load_shedding          = %s", loadShedding_?"true":"false");
+	if(loadShedding_)
+	{
+		RCLCPP_INFO(this->get_logger(), "Odometry: load_shedding_max_lag  = %f s", loadSheddingMaxLag_);
+		RCLCPP_INFO(this->get_logger(), "Odometry: load_shedding_max_skips = %d", loadSheddingMaxSkips_);
+	}
 	RCLCPP_INFO(this->get_logger(), "Odometry: wait_imu_to_init       = %s", waitIMUToinit_?"true":"false");
+	RCLCPP_INFO(this->get_logger(), "Odometry: imu_frame_queue_size   = %d", bufferedDataMaxSize_);
+	RCLCPP_INFO(this->get_logger(), "Odometry: latency_trace          = %s", latencyTrace_?"true":"false");
+	RCLCPP_INFO(this->get_logger(), "Odometry: latency_trace_size     = %d", latencyTraceSize);
+	RCLCPP_INFO(this->get_logger(), "Odometry: latency_trace_file     = %s", latencyTraceFile_.c_str());
+
+	if(latencyTrace_)
+	{
+		latencyTracer_.setCapacity(latencyTraceSize>0?latencyTraceSize:1);
+		latencyTracePub_ = create_publisher<rtabmap_ros::msg::LatencyTrace>("odom_latency_trace", 1);
+	}
 
 	configPath_ = uReplaceChar(configPath_, '~', UDirectory::homeDir());
 	if(configPath_.size() && configPath_.at(0) != '/')
@@ -171,6 +221,11 @@ OdometryROS::OdometryROS(const std::string & name, const rclcpp::NodeOptions & o
 
 OdometryROS::~OdometryROS()
 {
+	if(latencyTrace_ && !latencyTraceFile_.empty())
+	{
+		latencyTracer_.exportFile(latencyTraceFile_, this->get_name());
+	}
+
 	if(warningThread_)
 	{
 		callbackCalled();
@@ -178,6 +233,8 @@ OdometryROS::~OdometryROS()
 		delete warningThread_;
 	}
 
+	stopPipeline();
+	delete pipelineFeature2D_;
 	delete odometry_;
 }
 
@@ -315,6 +372,42 @@ void OdometryROS::init(bool stereoParams, bool visParams, bool icpParams)
 
 	odomStrategy_ = 0;
 	Parameters::parse(this->parameters(), Parameters::kOdomStrategy(), odomStrategy_);
+	if(pipelined_)
+	{
+		int imageDecimation = 1;
+		Parameters::parse(parameters_, Parameters::kOdomImageDecimation(), imageDecimation);
+		if(!visParams_ || (odometry_->getType() != Odometry::kTypeF2M && odometry_->getType() != Odometry::kTypeF2F))
+		{
+			RCLCPP_WARN(this->get_logger(), "odometry: \"pipelined\" is only supported by visual F2M and F2F odometry (%s=%d), it is disabled.",
+					Parameters::kOdomStrategy().c_str(), odomStrategy_);
+			pipelined_ = false;
+		}
+		else if(imageDecimation > 1)
+		{
+			// Features would be extracted on the full resolution image, while
+			// odometry decimates the image before registration.
+			RCLCPP_WARN(this->get_logger(), "odometry: \"pipelined\" cannot be used with %s>1, it is disabled.",
+					Parameters::kOdomImageDecimation().c_str());
+			pipelined_ = false;
+		}
+		else
+		{
+			// Same features than the visual registration
+			ParametersMap featureParameters = parameters_;
+			uInsert(featureParameters, ParametersPair(Parameters::kKpDetectorStrategy(), parameters_.at(Parameters::kVisFeatureType())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpMaxFeatures(), parameters_.at(Parameters::kVisMaxFeatures())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpMaxDepth(), parameters_.at(Parameters::kVisMaxDepth())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpMinDepth(), parameters_.at(Parameters::kVisMinDepth())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpRoiRatios(), parameters_.at(Parameters::kVisRoiRatios())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpSubPixEps(), parameters_.at(Parameters::kVisSubPixEps())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpSubPixIterations(), parameters_.at(Parameters::kVisSubPixIterations())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpSubPixWinSize(), parameters_.at(Parameters::kVisSubPixWinSize())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpGridRows(), parameters_.at(Parameters::kVisGridRows())));
+			uInsert(featureParameters, ParametersPair(Parameters::kKpGridCols(), parameters_.at(Parameters::kVisGridCols())));
+			Parameters::parse(parameters_, Parameters::kVisDepthAsMask(), pipelineDepthAsMask_);
+			pipelineFeature2D_ = Feature2D::create(featureParameters);
+		}
+	}
 	if(waitIMUToinit_ || odometry_->canProcessAsyncIMU())
 	{
 		int queueSize = 10;
@@ -432,16 +525,210 @@ void OdometryROS::callbackIMU(const sensor_msgs::msg::Imu::SharedPtr msg)
 			imuProcessed_ = true;
 			lastImuReceivedStamp_ = stamp;
 
-			if(bufferedData_.isValid() && stamp >= bufferedData_.stamp())
+			// Release in order frames older than this imu
+			while(!bufferedData_.empty() && stamp >= bufferedData_.front().data.stamp())
 			{
-				processData(bufferedData_, rclcpp::Time(bufferedData_.stamp()*10e9));
+				BufferedFrame frame = bufferedData_.front();
+				bufferedData_.pop_front();
+				bufferedDataWaitTime_ = (now() - frame.received).seconds();
+				processDataImpl(frame.data, frame.stamp, frame.trace);
 			}
-			bufferedData_ = SensorData();
+			bufferedDataWaitTime_ = 0.0;
 		}
 	}
 }
 
+void OdometryROS::callbackCalled()
+{
+	callbackCalled_ = true;
+	if(latencyTrace_ || loadShedding_)
+	{
+		latencyInput_ = InputTrace();
+		latencyInput_.input = now().seconds();
+	}
+}
+
+Transform OdometryROS::lookupTransform(const std::string & fromFrameId, const std::string & toFrameId, const rclcpp::Time & stamp)
+{
+	if(!latencyTrace_)
+	{
+		return getTransform(fromFrameId, toFrameId, stamp, *tfBuffer_, waitForTransform_);
+	}
+	double start = now().seconds();
+	Transform t = getTransform(fromFrameId, toFrameId, stamp, *tfBuffer_, waitForTransform_);
+	latencyInput_.tf += now().seconds() - start;
+	return t;
+}
+
 void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stamp)
+{
+	InputTrace trace;
+	if(latencyInput_.input > 0.0)
+	{
+		trace = latencyInput_;
+		trace.converted = now().seconds();
+		latencyInput_ = InputTrace();
+	}
+
+	// Before the pipeline hand-off, so that skipped frames are not extracted
+	if((!data.imageRaw().empty() || !data.laserScanRaw().isEmpty()) &&
+	   shedLoad(stamp, trace.input>0.0?trace.input:now().seconds()))
+	{
+		return;
+	}
+
+	if(pipelined_ && !data.imageRaw().empty())
+	{
+		// Extract features of this frame on the pipeline thread while
+		// the previous frame (already extracted) is registered.
+		if(pipelineThread_ == 0)
+		{
+			pipelineThread_ = new std::thread(&OdometryROS::pipelineThreadLoop, this);
+		}
+		waitPipeline();
+		SensorData previousData = pipelineData_;
+		rclcpp::Time previousStamp = pipelineStamp_;
+		InputTrace previousTrace = pipelineTrace_;
+
+		pipelineMutex_.lock();
+		pipelineData_ = data;
+		pipelineStamp_ = stamp;
+		pipelineTrace_ = trace;
+		pipelineBusy_ = true;
+		pipelineMutex_.unlock();
+		pipelineCondition_.notify_one();
+
+		if(previousData.isValid())
+		{
+			processDataImpl(previousData, previousStamp, previousTrace);
+		}
+		return;
+	}
+	processDataImpl(data, stamp, trace);
+}
+
+void OdometryROS::pipelineThreadLoop()
+{
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(pipelineMutex_);
+			pipelineCondition_.wait(lock, [this](){return pipelineStop_ || pipelineBusy_;});
+			if(pipelineStop_)
+			{
+				return;
+			}
+		}
+		// pipelineData_ is not modified by the other threads while busy
+		extractFeatures(pipelineData_);
+		{
+			std::unique_lock<std::mutex> lock(pipelineMutex_);
+			pipelineBusy_ = false;
+		}
+		pipelineDoneCondition_.notify_all();
+	}
+}
+
+void OdometryROS::waitPipeline()
+{
+	std::unique_lock<std::mutex> lock(pipelineMutex_);
+	pipelineDoneCondition_.wait(lock, [this](){return !pipelineBusy_;});
+}
+
+void OdometryROS::stopPipeline()
+{
+	if(pipelineThread_)
+	{
+		waitPipeline();
+		pipelineMutex_.lock();
+		pipelineStop_ = true;
+		pipelineMutex_.unlock();
+		pipelineCondition_.notify_one();
+		pipelineThread_->join();
+		delete pipelineThread_;
+		pipelineThread_ = 0;
+	}
+}
+
+void OdometryROS::extractFeatures(SensorData & data)
+{
+	UASSERT(pipelineFeature2D_ != 0);
+	UTimer timer;
+	cv::Mat imageMono;
+	if(data.imageRaw().channels() == 3)
+	{
+		cv::cvtColor(data.imageRaw(), imageMono, cv::COLOR_BGR2GRAY);
+	}
+	else
+	{
+		imageMono = data.imageRaw();
+	}
+
+	cv::Mat depthMask;
+	if(pipelineDepthAsMask_ &&
+	   !data.depthRaw().empty() &&
+	   imageMono.rows % data.depthRaw().rows == 0 &&
+	   imageMono.cols % data.depthRaw().cols == 0 &&
+	   imageMono.rows/data.depthRaw().rows == imageMono.cols/data.depthRaw().cols)
+	{
+		int factor = imageMono.rows/data.depthRaw().rows;
+		depthMask = factor>1?util2d::interpolate(data.depthRaw(), factor, 0.1f):data.depthRaw();
+	}
+
+	std::vector<cv::KeyPoint> keypoints = pipelineFeature2D_->generateKeypoints(imageMono, depthMask);
+	cv::Mat descriptors = pipelineFeature2D_->generateDescriptors(imageMono, keypoints);
+	std::vector<cv::Point3f> keypoints3D = pipelineFeature2D_->generateKeypoints3D(data, keypoints);
+	data.setFeatures(keypoints, keypoints3D, descriptors);
+	UDEBUG("Extracted %d features in pipeline (%fs)", (int)keypoints.size(), timer.ticks());
+}
+
+bool OdometryROS::shedLoad(const rclcpp::Time & stamp, double arrivalTime)
+{
+	double inputStamp = stamp.seconds();
+	if(loadSheddingLastInputStamp_ > 0.0 && inputStamp > loadSheddingLastInputStamp_)
+	{
+		double period = inputStamp - loadSheddingLastInputStamp_;
+		loadSheddingInputPeriod_ = loadSheddingInputPeriod_>0.0?0.9*loadSheddingInputPeriod_+0.1*period:period;
+	}
+	loadSheddingLastInputStamp_ = inputStamp;
+
+	if(!loadShedding_)
+	{
+		return false;
+	}
+
+	// Process only one frame on "decimation" if odometry is slower than the input rate
+	loadSheddingDecimation_ = 1;
+	if(loadSheddingInputPeriod_ > 0.0 && loadSheddingProcessTime_ > loadSheddingInputPeriod_)
+	{
+		loadSheddingDecimation_ = std::min((int)std::ceil(loadSheddingProcessTime_/loadSheddingInputPeriod_), loadSheddingMaxSkips_+1);
+	}
+
+	if(loadSheddingSkipped_ >= loadSheddingMaxSkips_)
+	{
+		return false;
+	}
+
+	// Frames are queued before the synchronized callback when odometry
+	// cannot follow, the pipeline and IMU waits are not counted
+	double lag = arrivalTime - inputStamp;
+	if(loadSheddingMaxLag_ > 0.0 && lag > loadSheddingMaxLag_)
+	{
+		UDEBUG("Skipping frame %f, lag %fs > %fs", inputStamp, lag, loadSheddingMaxLag_);
+		++loadSheddingSkipped_;
+		return true;
+	}
+	if(loadSheddingSkipped_+1 < loadSheddingDecimation_)
+	{
+		UDEBUG("Skipping frame %f, decimation=%d (process=%fs, input period=%fs)",
+				inputStamp, loadSheddingDecimation_, loadSheddingProcessTime_, loadSheddingInputPeriod_);
+		++loadSheddingSkipped_;
+		return true;
+	}
+	return false;
+}
+
+void OdometryROS::processDataImpl(const SensorData & data, const rclcpp::Time & stamp, const InputTrace & trace)
 {
 	if((waitIMUToinit_ && !imuProcessed_) && odometry_->framesProcessed() == 0 && odometry_->getPose().isIdentity() && data.imu().empty())
 	{
@@ -450,16 +737,30 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 	}
 
 	Transform groundTruth;
+	UTimer tfTimer;
+	double tfTime = 0.0; // ground truth and guess lookups
 	if(!data.imageRaw().empty() || !data.laserScanRaw().isEmpty())
 	{
 		if(odometry_->canProcessAsyncIMU() && data.imu().empty() && lastImuReceivedStamp_>0.0 && data.stamp() > lastImuReceivedStamp_)
 		{
 			//RCLCPP_WARN(this->get_logger(), "Data received is more recent than last imu received, waiting for imu update to process it.");
-			if(bufferedData_.isValid())
+			if((int)bufferedData_.size() >= bufferedDataMaxSize_)
+			{
+				RCLCPP_ERROR(this->get_logger(), "Too many frames waiting for IMU (imu_frame_queue_size=%d), dropping oldest one (stamp=%f)! "
+						"Make sure IMU is published faster than data rate.", bufferedDataMaxSize_, bufferedData_.front().data.stamp());
+				bufferedData_.pop_front();
+			}
+			BufferedFrame frame;
+			frame.data = data;
+			frame.stamp = stamp;
+			frame.received = now();
+			frame.trace = trace;
+			std::list<BufferedFrame>::iterator iter = bufferedData_.end();
+			while(iter != bufferedData_.begin() && std::prev(iter)->data.stamp() > data.stamp())
 			{
-				RCLCPP_ERROR(this->get_logger(), "Overwriting previous data! Make sure IMU is published faster than data rate.");
+				--iter;
 			}
-			bufferedData_ = data;
+			bufferedData_.insert(iter, frame);
 			return;
 		}
 
@@ -480,7 +781,9 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 
 		if(!groundTruthFrameId_.empty())
 		{
+			tfTimer.restart();
 			groundTruth = getTransform(groundTruthFrameId_, groundTruthBaseFrameId_, stamp, *tfBuffer_, waitForTransform_);
+			tfTime += tfTimer.elapsed();
 
 			if(!data.imageRaw().empty() || !data.laserScanRaw().isEmpty())
 			{
@@ -510,7 +813,9 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 	Transform guessCurrentPose;
 	if(!guessFrameId_.empty())
 	{
+		tfTimer.restart();
 		guessCurrentPose = getTransform(guessFrameId_, frameId_, stamp, *tfBuffer_, waitForTransform_);
+		tfTime += tfTimer.elapsed();
 		Transform previousPose = guessPreviousPose_.isNull()?guessCurrentPose:guessPreviousPose_;
 		if(!previousPose.isNull() && !guessCurrentPose.isNull())
 		{
@@ -563,7 +868,13 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 		dataCpy.setGroundTruth(groundTruth);
 	}
 	rtabmap::Transform pose = odometry_->process(dataCpy, guess_, &info);
+	rclcpp::Time timeOdom = now();
 	guess_.setNull();
+	if(!data.imageRaw().empty() || !data.laserScanRaw().isEmpty())
+	{
+		double processTime = (timeOdom-timeStart).seconds();
+		loadSheddingProcessTime_ = loadSheddingProcessTime_>0.0?0.9*loadSheddingProcessTime_+0.1*processTime:processTime;
+	}
 	if(!pose.isNull())
 	{
 		resetCurrentCount_ = resetCountdown_;
@@ -650,20 +961,14 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 		// local map / reference frame
 		if(odomLocalMap_->get_subscription_count() && !info.localMap.empty())
 		{
-			pcl::PointCloud<pcl::PointXYZRGB> cloud;
-			for(std::map<int, cv::Point3f>::const_iterator iter=info.localMap.begin(); iter!=info.localMap.end(); ++iter)
+			sensor_msgs::msg::PointCloud2 cloudMsg;
+			PointCloud2Writer writer(cloudMsg, info.localMap.size(), true);
+			size_t i=0;
+			for(std::map<int, cv::Point3f>::const_iterator iter=info.localMap.begin(); iter!=info.localMap.end(); ++iter, ++i)
 			{
 				bool inlier = info.words.find(iter->first) != info.words.end();
-				pcl::PointXYZRGB pt;
-				pt.r = inlier?0:255;
-				pt.g = 255;
-				pt.x = iter->second.x;
-				pt.y = iter->second.y;
-				pt.z = iter->second.z;
-				cloud.push_back(pt);
+				writer.set(i, iter->second.x, iter->second.y, iter->second.z, inlier?0:255, 255, 0);
 			}
-			sensor_msgs::msg::PointCloud2 cloudMsg;
-			pcl::toROSMsg(cloud, cloudMsg);
 			cloudMsg.header.stamp = stamp; // use corresponding time stamp to image
 			cloudMsg.header.frame_id = odomFrameId_;
 			odomLocalMap_->publish(cloudMsg);
@@ -677,16 +982,9 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 				const std::vector<cv::Point3f> & words3  = ((OdometryF2M*)odometry_)->getLastFrame().getWords3();
 				if(words3.size())
 				{
-					pcl::PointCloud<pcl::PointXYZ> cloud;
-					for(std::vector<cv::Point3f>::const_iterator iter=words3.begin(); iter!=words3.end(); ++iter)
-					{
-						// transform to odom frame
-						cv::Point3f pt = util3d::transformPoint(*iter, pose);
-						cloud.push_back(pcl::PointXYZ(pt.x, pt.y, pt.z));
-					}
-
+					// transform to odom frame
 					sensor_msgs::msg::PointCloud2 cloudMsg;
-					pcl::toROSMsg(cloud, cloudMsg);
+					points3fToROS(words3, cloudMsg, pose);
 					cloudMsg.header.stamp = stamp; // use corresponding time stamp to image
 					cloudMsg.header.frame_id = odomFrameId_;
 					odomLastFrame_->publish(cloudMsg);
@@ -698,15 +996,9 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 
 				if(refFrame.getWords3().size())
 				{
-					pcl::PointCloud<pcl::PointXYZ> cloud;
-					for(std::vector<cv::Point3f>::const_iterator iter=refFrame.getWords3().begin(); iter!=refFrame.getWords3().end(); ++iter)
-					{
-						// transform to odom frame
-						cv::Point3f pt = util3d::transformPoint(*iter, pose);
-						cloud.push_back(pcl::PointXYZ(pt.x, pt.y, pt.z));
-					}
+					// transform to odom frame
 					sensor_msgs::msg::PointCloud2 cloudMsg;
-					pcl::toROSMsg(cloud, cloudMsg);
+					points3fToROS(refFrame.getWords3(), cloudMsg, pose);
 					cloudMsg.header.stamp = stamp; // use corresponding time stamp to image
 					cloudMsg.header.frame_id = odomFrameId_;
 					odomLastFrame_->publish(cloudMsg);
@@ -717,17 +1009,7 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 		if(odomLocalScanMap_->get_subscription_count() && !info.localScanMap.isEmpty())
 		{
 			sensor_msgs::msg::PointCloud2 cloudMsg;
-			if(info.localScanMap.hasNormals())
-			{
-				pcl::PointCloud<pcl::PointNormal>::Ptr cloud = util3d::laserScanToPointCloudNormal(info.localScanMap, info.localScanMap.localTransform());
-				pcl::toROSMsg(*cloud, cloudMsg);
-			}
-			else
-			{
-				pcl::PointCloud<pcl::PointXYZ>::Ptr cloud = util3d::laserScanToPointCloud(info.localScanMap, info.localScanMap.localTransform());
-				pcl::toROSMsg(*cloud, cloudMsg);
-			}
-
+			laserScanToROS(info.localScanMap, cloudMsg, info.localScanMap.localTransform());
 			cloudMsg.header.stamp = stamp; // use corresponding time stamp to image
 			cloudMsg.header.frame_id = odomFrameId_;
 			odomLocalScanMap_->publish(cloudMsg);
@@ -793,8 +1075,41 @@ void OdometryROS::processData(const SensorData & data, const rclcpp::Time & stam
 		odomInfoToROS(info, infoMsg);
 		infoMsg.header.stamp = stamp; // use corresponding time stamp to image
 		infoMsg.header.frame_id = odomFrameId_;
+		infoMsg.imu_queue_size = bufferedData_.size();
+		infoMsg.imu_queue_wait_time = bufferedDataWaitTime_;
+		infoMsg.frames_skipped = loadSheddingSkipped_;
+		infoMsg.decimation = loadSheddingDecimation_;
 		odomInfoPub_->publish(infoMsg);
 	}
+	if(!data.imageRaw().empty() || !data.laserScanRaw().isEmpty())
+	{
+		loadSheddingSkipped_ = 0;
+	}
+
+	if(latencyTrace_)
+	{
+		rclcpp::Time timeEnd = now();
+		rtabmap_ros::msg::LatencyTrace traceMsg;
+		traceMsg.header.stamp = stamp;
+		traceMsg.header.frame_id = odomFrameId_;
+		// sync: sensor stamp -> synchronized callback
+		// tf: TF lookups of the callback, ground truth and guess
+		// conversion: sensor messages -> SensorData
+		// queue: waiting for the feature extraction pipeline or IMU
+		double start = timeStart.seconds();
+		double inputTime = trace.input>0.0?trace.input:start;
+		double convertedTime = trace.converted>=inputTime?trace.converted:inputTime;
+		latencyTracer_.record("sync", stamp.seconds(), stamp.seconds(), inputTime-stamp.seconds(), &traceMsg);
+		latencyTracer_.record("tf", stamp.seconds(), inputTime, trace.tf+tfTime, &traceMsg);
+		latencyTracer_.record("conversion", stamp.seconds(), inputTime+trace.tf, std::max(0.0, convertedTime-inputTime-trace.tf), &traceMsg);
+		latencyTracer_.record("queue", stamp.seconds(), convertedTime, std::max(0.0, start-convertedTime-tfTime), &traceMsg);
+		latencyTracer_.record("odometry", stamp.seconds(), timeStart.seconds(), (timeOdom-timeStart).seconds(), &traceMsg);
+		latencyTracer_.record("odom_publish", stamp.seconds(), timeOdom.seconds(), (timeEnd-timeOdom).seconds(), &traceMsg);
+		if(latencyTracePub_->get_subscription_count())
+		{
+			latencyTracePub_->publish(traceMsg);
+		}
+	}
 
 	if(!data.imageRaw().empty() || !data.laserScanRaw().isEmpty())
 	{
@@ -838,13 +1153,20 @@ void OdometryROS::resetToPose(
 
 void OdometryROS::reset(const Transform & pose)
 {
+	// The frame waiting in the pipeline was received before the reset: like
+	// the frames waiting for IMU, it is dropped and its features with it.
+	waitPipeline();
+	pipelineData_ = SensorData();
 	odometry_->reset(pose);
 	guess_.setNull();
 	guessPreviousPose_.setNull();
 	previousStamp_ = 0.0;
 	resetCurrentCount_ = resetCountdown_;
 	imuProcessed_ = false;
-	bufferedData_= SensorData();
+	bufferedData_.clear();
+	bufferedDataWaitTime_ = 0.0;
+	loadSheddingLastInputStamp_ = 0.0;
+	loadSheddingSkipped_ = 0;
 	lastImuReceivedStamp_=0.0;
 	this->flushCallbacks();
 }
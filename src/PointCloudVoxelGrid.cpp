@@ -0,0 +1,155 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "rtabmap_ros/PointCloudVoxelGrid.h"
+
+#include <rtabmap/utilite/ULogger.h>
+#include <cmath>
+
+namespace rtabmap_ros {
+
+PointCloudVoxelGrid::PointCloudVoxelGrid(float voxelSize) :
+		voxelSize_(0.0f),
+		cloud_(new pcl::PointCloud<pcl::PointXYZRGB>)
+{
+	setVoxelSize(voxelSize);
+}
+
+bool PointCloudVoxelGrid::setVoxelSize(float voxelSize)
+{
+	UASSERT(voxelSize > 0.0f);
+	if(voxelSize != voxelSize_)
+	{
+		clear();
+		voxelSize_ = voxelSize;
+		return true;
+	}
+	return false;
+}
+
+void PointCloudVoxelGrid::clear()
+{
+	voxels_.clear();
+	keys_.clear();
+	cloud_->clear();
+}
+
+long long PointCloudVoxelGrid::key(const pcl::PointXYZRGB & pt) const
+{
+	// 21 bits per axis, voxels aligned on the origin like pcl::VoxelGrid
+	int x = (int)std::floor(pt.x / voxelSize_);
+	int y = (int)std::floor(pt.y / voxelSize_);
+	int z = (int)std::floor(pt.z / voxelSize_);
+	return ((long long)(x & 0x1FFFFF) << 42) | ((long long)(y & 0x1FFFFF) << 21) | (long long)(z & 0x1FFFFF);
+}
+
+void PointCloudVoxelGrid::updatePoint(int index)
+{
+	const Voxel & v = voxels_.at(keys_[index]);
+	pcl::PointXYZRGB & pt = cloud_->at(index);
+	pt.x = float(v.x / v.count);
+	pt.y = float(v.y / v.count);
+	pt.z = float(v.z / v.count);
+	pt.r = (unsigned char)(v.r / v.count);
+	pt.g = (unsigned char)(v.g / v.count);
+	pt.b = (unsigned char)(v.b / v.count);
+}
+
+void PointCloudVoxelGrid::addPoints(const pcl::PointCloud<pcl::PointXYZRGB> & cloud, int offset, int size)
+{
+	int end = size<0?(int)cloud.size():offset+size;
+	UASSERT(offset >= 0 && end <= (int)cloud.size());
+	for(int i=offset; i<end; ++i)
+	{
+		const pcl::PointXYZRGB & pt = cloud.at(i);
+		if(pcl::isFinite(pt))
+		{
+			long long k = key(pt);
+			Voxel & v = voxels_[k];
+			if(v.count == 0)
+			{
+				v.index = (int)cloud_->size();
+				keys_.push_back(k);
+				cloud_->push_back(pt);
+			}
+			v.x += pt.x;
+			v.y += pt.y;
+			v.z += pt.z;
+			v.r += pt.r;
+			v.g += pt.g;
+			v.b += pt.b;
+			++v.count;
+			updatePoint(v.index);
+		}
+	}
+}
+
+void PointCloudVoxelGrid::removePoints(const pcl::PointCloud<pcl::PointXYZRGB> & cloud, int offset, int size)
+{
+	int end = size<0?(int)cloud.size():offset+size;
+	UASSERT(offset >= 0 && end <= (int)cloud.size());
+	for(int i=offset; i<end; ++i)
+	{
+		const pcl::PointXYZRGB & pt = cloud.at(i);
+		if(pcl::isFinite(pt))
+		{
+			std::unordered_map<long long, Voxel>::iterator iter = voxels_.find(key(pt));
+			if(iter == voxels_.end())
+			{
+				UWARN("Point (%f,%f,%f) not found in the voxel grid!", pt.x, pt.y, pt.z);
+				continue;
+			}
+			Voxel & v = iter->second;
+			if(--v.count == 0)
+			{
+				// move the last point of the output in place of the empty voxel
+				int last = (int)cloud_->size()-1;
+				if(v.index != last)
+				{
+					cloud_->at(v.index) = cloud_->at(last);
+					keys_[v.index] = keys_[last];
+					voxels_.at(keys_[v.index]).index = v.index;
+				}
+				cloud_->resize(last);
+				keys_.pop_back();
+				voxels_.erase(iter);
+			}
+			else
+			{
+				v.x -= pt.x;
+				v.y -= pt.y;
+				v.z -= pt.z;
+				v.r -= pt.r;
+				v.g -= pt.g;
+				v.b -= pt.b;
+				updatePoint(v.index);
+			}
+		}
+	}
+}
+
+} /* namespace rtabmap_ros */
@@ -0,0 +1,170 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "rtabmap_ros/PointCloudVoxelHash.h"
+
+#include <rtabmap/utilite/ULogger.h>
+#include <cmath>
+
+namespace rtabmap_ros {
+
+PointCloudVoxelHash::PointCloudVoxelHash(float radius) :
+		radius_(0.0f),
+		radiusSqr_(0.0f),
+		size_(0)
+{
+	setRadius(radius);
+}
+
+void PointCloudVoxelHash::setRadius(float radius)
+{
+	UASSERT(radius > 0.0f);
+	if(radius != radius_)
+	{
+		clear();
+		radius_ = radius;
+		radiusSqr_ = radius*radius;
+	}
+}
+
+void PointCloudVoxelHash::clear()
+{
+	cells_.clear();
+	size_ = 0;
+}
+
+long long PointCloudVoxelHash::key(int x, int y, int z) const
+{
+	// 21 bits per axis
+	return ((long long)(x & 0x1FFFFF) << 42) | ((long long)(y & 0x1FFFFF) << 21) | (long long)(z & 0x1FFFFF);
+}
+
+int PointCloudVoxelHash::cell(float v) const
+{
+	return (int)std::floor(v / radius_);
+}
+
+void PointCloudVoxelHash::addPoints(const pcl::PointCloud<pcl::PointXYZRGB> & cloud, int offset, int size)
+{
+	int end = size<0?(int)cloud.size():offset+size;
+	UASSERT(offset >= 0 && end <= (int)cloud.size());
+	for(int i=offset; i<end; ++i)
+	{
+		const pcl::PointXYZRGB & pt = cloud.at(i);
+		if(pcl::isFinite(pt))
+		{
+			cells_[key(cell(pt.x), cell(pt.y), cell(pt.z))].push_back(cv::Point3f(pt.x, pt.y, pt.z));
+			++size_;
+		}
+	}
+}
+
+void PointCloudVoxelHash::removePoints(const pcl::PointCloud<pcl::PointXYZRGB> & cloud, int offset, int size)
+{
+	int end = size<0?(int)cloud.size():offset+size;
+	UASSERT(offset >= 0 && end <= (int)cloud.size());
+	for(int i=offset; i<end; ++i)
+	{
+		const pcl::PointXYZRGB & pt = cloud.at(i);
+		if(pcl::isFinite(pt))
+		{
+			std::unordered_map<long long, std::vector<cv::Point3f> >::iterator iter = cells_.find(key(cell(pt.x), cell(pt.y), cell(pt.z)));
+			if(iter != cells_.end())
+			{
+				std::vector<cv::Point3f> & points = iter->second;
+				for(unsigned int j=0; j<points.size(); ++j)
+				{
+					if(points[j].x == pt.x && points[j].y == pt.y && points[j].z == pt.z)
+					{
+						points[j] = points.back();
+						points.pop_back();
+						--size_;
+						break;
+					}
+				}
+				if(points.empty())
+				{
+					cells_.erase(iter);
+				}
+			}
+		}
+	}
+}
+
+int PointCloudVoxelHash::radiusNeighbors(const pcl::PointXYZRGB & pt, int maxNeighbors) const
+{
+	int count = 0;
+	int cx = cell(pt.x);
+	int cy = cell(pt.y);
+	int cz = cell(pt.z);
+	for(int x=cx-1; x<=cx+1; ++x)
+	{
+		for(int y=cy-1; y<=cy+1; ++y)
+		{
+			for(int z=cz-1; z<=cz+1; ++z)
+			{
+				std::unordered_map<long long, std::vector<cv::Point3f> >::const_iterator iter = cells_.find(key(x, y, z));
+				if(iter != cells_.end())
+				{
+					for(unsigned int i=0; i<iter->second.size(); ++i)
+					{
+						const cv::Point3f & n = iter->second[i];
+						float dx = n.x - pt.x;
+						float dy = n.y - pt.y;
+						float dz = n.z - pt.z;
+						if(dx*dx + dy*dy + dz*dz <= radiusSqr_ && ++count >= maxNeighbors)
+						{
+							return count;
+						}
+					}
+				}
+			}
+		}
+	}
+	return count;
+}
+
+pcl::PointCloud<pcl::PointXYZRGB>::Ptr PointCloudVoxelHash::subtract(
+		const pcl::PointCloud<pcl::PointXYZRGB> & cloud,
+		int minNeighborsInRadius) const
+{
+	UASSERT(minNeighborsInRadius > 0);
+	pcl::PointCloud<pcl::PointXYZRGB>::Ptr output(new pcl::PointCloud<pcl::PointXYZRGB>);
+	output->resize(cloud.size());
+	int oi = 0; // output iterator
+	for(unsigned int i=0; i<cloud.size(); ++i)
+	{
+		if(cells_.empty() || radiusNeighbors(cloud.at(i), minNeighborsInRadius) < minNeighborsInRadius)
+		{
+			output->at(oi++) = cloud.at(i);
+		}
+	}
+	output->resize(oi);
+	return output;
+}
+
+} /* namespace rtabmap_ros */
@@ -0,0 +1,144 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "rtabmap_ros/MsgConversion.h"
+#include <rtabmap/utilite/UTimer.h>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void showUsage()
+{
+	printf("\nUsage:\n"
+			"transform_cloud_benchmark [options]\n"
+			"  Compare rtabmap_ros::transformPointCloud() with a per-point\n"
+			"  transform on a random PointCloud2 (XYZ float fields).\n"
+			"Options:\n"
+			"  -n #    Number of points (default 307200).\n"
+			"  -i #    Iterations (default 50).\n");
+	exit(1);
+}
+
+// Per-point transform, like the former implementation
+void transformPerPoint(const Eigen::Matrix4f & transform, sensor_msgs::msg::PointCloud2 & cloud)
+{
+	int xOffset = cloud.fields[pcl::getFieldIndex(cloud, "x")].offset;
+	int yOffset = cloud.fields[pcl::getFieldIndex(cloud, "y")].offset;
+	int zOffset = cloud.fields[pcl::getFieldIndex(cloud, "z")].offset;
+	for(size_t i=0; i<(size_t)cloud.width*cloud.height; ++i)
+	{
+		unsigned char * ptr = &cloud.data[(i / cloud.width) * cloud.row_step + (i % cloud.width) * cloud.point_step];
+		Eigen::Vector4f pt(0,0,0,1);
+		memcpy(&pt[0], ptr + xOffset, sizeof(float));
+		memcpy(&pt[1], ptr + yOffset, sizeof(float));
+		memcpy(&pt[2], ptr + zOffset, sizeof(float));
+		if(!std::isfinite(pt[0]) || !std::isfinite(pt[1]) || !std::isfinite(pt[2]))
+		{
+			continue;
+		}
+		pt = transform * pt;
+		memcpy(ptr + xOffset, &pt[0], sizeof(float));
+		memcpy(ptr + yOffset, &pt[1], sizeof(float));
+		memcpy(ptr + zOffset, &pt[2], sizeof(float));
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int points = 640*480;
+	int iterations = 50;
+	for(int i=1; i<argc; ++i)
+	{
+		if(strcmp(argv[i], "-n") == 0 && i+1<argc)
+		{
+			points = atoi(argv[++i]);
+		}
+		else if(strcmp(argv[i], "-i") == 0 && i+1<argc)
+		{
+			iterations = atoi(argv[++i]);
+		}
+		else
+		{
+			showUsage();
+		}
+	}
+	if(points <= 0 || iterations <= 0)
+	{
+		showUsage();
+	}
+
+	pcl::PointCloud<pcl::PointXYZ> cloud;
+	cloud.resize(points);
+	for(int i=0; i<points; ++i)
+	{
+		cloud[i].x = float(rand())/float(RAND_MAX)*10.0f;
+		cloud[i].y = float(rand())/float(RAND_MAX)*10.0f - 5.0f;
+		cloud[i].z = float(rand())/float(RAND_MAX)*2.0f;
+	}
+	sensor_msgs::msg::PointCloud2 input;
+	pcl::toROSMsg(cloud, input);
+
+	Eigen::Affine3f t = Eigen::Translation3f(0.1f, -0.2f, 0.3f) * Eigen::AngleAxisf(0.3f, Eigen::Vector3f(0.2f, 0.5f, 1.0f).normalized());
+	const Eigen::Matrix4f & transform = t.matrix();
+
+	sensor_msgs::msg::PointCloud2 reference = input;
+	sensor_msgs::msg::PointCloud2 output = input;
+	UTimer timer;
+	for(int n=0; n<iterations; ++n)
+	{
+		memcpy(reference.data.data(), input.data.data(), input.data.size());
+		transformPerPoint(transform, reference);
+	}
+	double perPointTime = timer.ticks()/double(iterations);
+	for(int n=0; n<iterations; ++n)
+	{
+		rtabmap_ros::transformPointCloud(transform, input, output);
+	}
+	double blockTime = timer.ticks()/double(iterations);
+
+	pcl::PointCloud<pcl::PointXYZ> a, b;
+	pcl::fromROSMsg(reference, a);
+	pcl::fromROSMsg(output, b);
+	float maxError = 0.0f;
+	for(int i=0; i<points; ++i)
+	{
+		maxError = std::max(maxError, (a[i].getVector3fMap() - b[i].getVector3fMap()).cwiseAbs().maxCoeff());
+	}
+
+	printf("%d points, %d iterations (copy of the input included)\n", points, iterations);
+	printf("%-12s %12s %12s\n", "method", "time (ms)", "Mpts/s");
+	printf("%-12s %12.3f %12.1f\n", "per point", perPointTime*1000.0, double(points)/perPointTime/1000000.0);
+	printf("%-12s %12.3f %12.1f\n", "blocks", blockTime*1000.0, double(points)/blockTime/1000000.0);
+	printf("max error = %g\n", maxError);
+	return maxError < 1e-4f?0:1;
+}
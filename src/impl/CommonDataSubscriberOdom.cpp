@@ -78,6 +78,7 @@ void CommonDataSubscriber::setupOdomCallbacks(
 	{
 		odomSub_.subscribe(&node, "odom", rmw_qos_profile_sensor_data);
 
+#ifdef RTABMAP_SYNC_USER_DATA
 		if(subscribeUserData)
 		{
 			userDataSub_.subscribe(&node, "user_data", rmw_qos_profile_sensor_data);
@@ -85,18 +86,20 @@ void CommonDataSubscriber::setupOdomCallbacks(
 			{
 				subscribedToOdomInfo_ = true;
 				odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-				SYNC_DECL3(odomDataInfo, approxSync, queueSize, odomSub_, userDataSub_, odomInfoSub_);
+				SYNC_DECL(odomDataInfo, approxSync, queueSize, odomSub_, userDataSub_, odomInfoSub_);
 			}
 			else
 			{
-				SYNC_DECL2(odomData, approxSync, queueSize, odomSub_, userDataSub_);
+				SYNC_DECL(odomData, approxSync, queueSize, odomSub_, userDataSub_);
 			}
 		}
-		else if(subscribeOdomInfo)
+		else
+#endif
+		if(subscribeOdomInfo)
 		{
 			subscribedToOdomInfo_ = true;
 			odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-			SYNC_DECL2(odomInfo, approxSync, queueSize, odomSub_, odomInfoSub_);
+			SYNC_DECL(odomInfo, approxSync, queueSize, odomSub_, odomInfoSub_);
 		}
 	}
 	else
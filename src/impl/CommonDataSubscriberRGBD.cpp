@@ -371,6 +371,7 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 		rgbdSubs_[0]->subscribe(&node, "rgbd_image", rmw_qos_profile_sensor_data);
 
 
+#ifdef RTABMAP_SYNC_USER_DATA
 		if(subscribeOdom && subscribeUserData)
 		{
 			odomSub_.subscribe(&node, "odom", rmw_qos_profile_sensor_data);
@@ -383,11 +384,11 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL5(rgbdOdomDataScan2dInfo, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), scanSub_, odomInfoSub_);
+					SYNC_DECL(rgbdOdomDataScan2dInfo, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), scanSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL4(rgbdOdomDataScan2d, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), scanSub_);
+					SYNC_DECL(rgbdOdomDataScan2d, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), scanSub_);
 				}
 			}
 			else if(subscribeScan3d)
@@ -398,25 +399,27 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL5(rgbdOdomDataScan3dInfo, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), scan3dSub_, odomInfoSub_);
+					SYNC_DECL(rgbdOdomDataScan3dInfo, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), scan3dSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL4(rgbdOdomDataScan3d, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), scan3dSub_);
+					SYNC_DECL(rgbdOdomDataScan3d, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), scan3dSub_);
 				}
 			}
 			else if(subscribeOdomInfo)
 			{
 				subscribedToOdomInfo_ = true;
 				odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-				SYNC_DECL4(rgbdOdomDataInfo, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), odomInfoSub_);
+				SYNC_DECL(rgbdOdomDataInfo, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]), odomInfoSub_);
 			}
 			else
 			{
-				SYNC_DECL3(rgbdOdomData, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]));
+				SYNC_DECL(rgbdOdomData, approxSync, queueSize, odomSub_, userDataSub_, (*rgbdSubs_[0]));
 			}
 		}
-		else if(subscribeOdom)
+		else
+#endif
+		if(subscribeOdom)
 		{
 			odomSub_.subscribe(&node, "odom", rmw_qos_profile_sensor_data);
 			if(subscribeScan2d)
@@ -427,11 +430,11 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL4(rgbdOdomScan2dInfo, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), scanSub_, odomInfoSub_);
+					SYNC_DECL(rgbdOdomScan2dInfo, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), scanSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL3(rgbdOdomScan2d, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), scanSub_);
+					SYNC_DECL(rgbdOdomScan2d, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), scanSub_);
 				}
 			}
 			else if(subscribeScan3d)
@@ -442,24 +445,25 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL4(rgbdOdomScan3dInfo, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), scan3dSub_, odomInfoSub_);
+					SYNC_DECL(rgbdOdomScan3dInfo, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), scan3dSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL3(rgbdOdomScan3d, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), scan3dSub_);
+					SYNC_DECL(rgbdOdomScan3d, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), scan3dSub_);
 				}
 			}
 			else if(subscribeOdomInfo)
 			{
 				subscribedToOdomInfo_ = true;
 				odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-				SYNC_DECL3(rgbdOdomInfo, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), odomInfoSub_);
+				SYNC_DECL(rgbdOdomInfo, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]), odomInfoSub_);
 			}
 			else
 			{
-				SYNC_DECL2(rgbdOdom, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]));
+				SYNC_DECL(rgbdOdom, approxSync, queueSize, odomSub_, (*rgbdSubs_[0]));
 			}
 		}
+#ifdef RTABMAP_SYNC_USER_DATA
 		else if(subscribeUserData)
 		{
 			userDataSub_.subscribe(&node, "user_data", rmw_qos_profile_sensor_data);
@@ -471,11 +475,11 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL4(rgbdDataScan2dInfo, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), scanSub_, odomInfoSub_);
+					SYNC_DECL(rgbdDataScan2dInfo, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), scanSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL3(rgbdDataScan2d, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), scanSub_);
+					SYNC_DECL(rgbdDataScan2d, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), scanSub_);
 				}
 			}
 			else if(subscribeScan3d)
@@ -486,24 +490,25 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL4(rgbdDataScan3dInfo, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), scan3dSub_, odomInfoSub_);
+					SYNC_DECL(rgbdDataScan3dInfo, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), scan3dSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL3(rgbdDataScan3d, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), scan3dSub_);
+					SYNC_DECL(rgbdDataScan3d, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), scan3dSub_);
 				}
 			}
 			else if(subscribeOdomInfo)
 			{
 				subscribedToOdomInfo_ = true;
 				odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-				SYNC_DECL3(rgbdDataInfo, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), odomInfoSub_);
+				SYNC_DECL(rgbdDataInfo, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]), odomInfoSub_);
 			}
 			else
 			{
-				SYNC_DECL2(rgbdData, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]));
+				SYNC_DECL(rgbdData, approxSync, queueSize, userDataSub_, (*rgbdSubs_[0]));
 			}
 		}
+#endif
 		else
 		{
 			if(subscribeScan2d)
@@ -514,11 +519,11 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL3(rgbdScan2dInfo, approxSync, queueSize, (*rgbdSubs_[0]), scanSub_, odomInfoSub_);
+					SYNC_DECL(rgbdScan2dInfo, approxSync, queueSize, (*rgbdSubs_[0]), scanSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL2(rgbdScan2d, approxSync, queueSize, (*rgbdSubs_[0]), scanSub_);
+					SYNC_DECL(rgbdScan2d, approxSync, queueSize, (*rgbdSubs_[0]), scanSub_);
 				}
 			}
 			else if(subscribeScan3d)
@@ -529,18 +534,18 @@ void CommonDataSubscriber::setupRGBDCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL3(rgbdScan3dInfo, approxSync, queueSize, (*rgbdSubs_[0]), scan3dSub_, odomInfoSub_);
+					SYNC_DECL(rgbdScan3dInfo, approxSync, queueSize, (*rgbdSubs_[0]), scan3dSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL2(rgbdScan3d, approxSync, queueSize, (*rgbdSubs_[0]), scan3dSub_);
+					SYNC_DECL(rgbdScan3d, approxSync, queueSize, (*rgbdSubs_[0]), scan3dSub_);
 				}
 			}
 			else if(subscribeOdomInfo)
 			{
 				subscribedToOdomInfo_ = true;
 				odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-				SYNC_DECL2(rgbdInfo, approxSync, queueSize, (*rgbdSubs_[0]), odomInfoSub_);
+				SYNC_DECL(rgbdInfo, approxSync, queueSize, (*rgbdSubs_[0]), odomInfoSub_);
 			}
 			else
 			{
@@ -217,6 +217,7 @@ void CommonDataSubscriber::setupScanCallbacks(
 			scan3dSub_.subscribe(&node, "scan_cloud", rmw_qos_profile_sensor_data);
 		}
 
+#ifdef RTABMAP_SYNC_USER_DATA
 		if(subscribeOdom && subscribeUserData)
 		{
 			odomSub_.subscribe(&node, "odom", rmw_qos_profile_sensor_data);
@@ -228,11 +229,11 @@ void CommonDataSubscriber::setupScanCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL4(odomDataScan2dInfo, approxSync, queueSize, odomSub_, userDataSub_, scanSub_, odomInfoSub_);
+					SYNC_DECL(odomDataScan2dInfo, approxSync, queueSize, odomSub_, userDataSub_, scanSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL3(odomDataScan2d, approxSync, queueSize, odomSub_, userDataSub_, scanSub_);
+					SYNC_DECL(odomDataScan2d, approxSync, queueSize, odomSub_, userDataSub_, scanSub_);
 				}
 			}
 			else
@@ -241,15 +242,17 @@ void CommonDataSubscriber::setupScanCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL4(odomDataScan3dInfo, approxSync, queueSize, odomSub_, userDataSub_, scan3dSub_, odomInfoSub_);
+					SYNC_DECL(odomDataScan3dInfo, approxSync, queueSize, odomSub_, userDataSub_, scan3dSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL3(odomDataScan3d, approxSync, queueSize, odomSub_, userDataSub_, scan3dSub_);
+					SYNC_DECL(odomDataScan3d, approxSync, queueSize, odomSub_, userDataSub_, scan3dSub_);
 				}
 			}
 		}
-		else if(subscribeOdom)
+		else
+#endif
+		if(subscribeOdom)
 		{
 			odomSub_.subscribe(&node, "odom", rmw_qos_profile_sensor_data);
 
@@ -259,11 +262,11 @@ void CommonDataSubscriber::setupScanCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL3(odomScan2dInfo, approxSync, queueSize, odomSub_, scanSub_, odomInfoSub_);
+					SYNC_DECL(odomScan2dInfo, approxSync, queueSize, odomSub_, scanSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL2(odomScan2d, approxSync, queueSize, odomSub_, scanSub_);
+					SYNC_DECL(odomScan2d, approxSync, queueSize, odomSub_, scanSub_);
 				}
 			}
 			else
@@ -272,14 +275,15 @@ void CommonDataSubscriber::setupScanCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL3(odomScan3dInfo, approxSync, queueSize, odomSub_, scan3dSub_, odomInfoSub_);
+					SYNC_DECL(odomScan3dInfo, approxSync, queueSize, odomSub_, scan3dSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL2(odomScan3d, approxSync, queueSize, odomSub_, scan3dSub_);
+					SYNC_DECL(odomScan3d, approxSync, queueSize, odomSub_, scan3dSub_);
 				}
 			}
 		}
+#ifdef RTABMAP_SYNC_USER_DATA
 		else if(subscribeUserData)
 		{
 			userDataSub_.subscribe(&node, "user_data", rmw_qos_profile_sensor_data);
@@ -290,11 +294,11 @@ void CommonDataSubscriber::setupScanCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL3(dataScan2dInfo, approxSync, queueSize, userDataSub_, scanSub_, odomInfoSub_);
+					SYNC_DECL(dataScan2dInfo, approxSync, queueSize, userDataSub_, scanSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL2(dataScan2d, approxSync, queueSize, userDataSub_, scanSub_);
+					SYNC_DECL(dataScan2d, approxSync, queueSize, userDataSub_, scanSub_);
 				}
 			}
 			else
@@ -303,14 +307,15 @@ void CommonDataSubscriber::setupScanCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL3(dataScan3dInfo, approxSync, queueSize, userDataSub_, scan3dSub_, odomInfoSub_);
+					SYNC_DECL(dataScan3dInfo, approxSync, queueSize, userDataSub_, scan3dSub_, odomInfoSub_);
 				}
 				else
 				{
-					SYNC_DECL2(dataScan3d, approxSync, queueSize, userDataSub_, scan3dSub_);
+					SYNC_DECL(dataScan3d, approxSync, queueSize, userDataSub_, scan3dSub_);
 				}
 			}
 		}
+#endif
 		else
 		{
 			if(scan2dTopic)
@@ -319,7 +324,7 @@ void CommonDataSubscriber::setupScanCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL2(scan2dInfo, approxSync, queueSize, scanSub_, odomInfoSub_);
+					SYNC_DECL(scan2dInfo, approxSync, queueSize, scanSub_, odomInfoSub_);
 				}
 			}
 			else
@@ -328,7 +333,7 @@ void CommonDataSubscriber::setupScanCallbacks(
 				{
 					subscribedToOdomInfo_ = true;
 					odomInfoSub_.subscribe(&node, "odom_info", rmw_qos_profile_sensor_data);
-					SYNC_DECL2(scan3dInfo, approxSync, queueSize, scan3dSub_, odomInfoSub_);
+					SYNC_DECL(scan3dInfo, approxSync, queueSize, scan3dSub_, odomInfoSub_);
 				}
 			}
 		}
@@ -0,0 +1,54 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SRC_IMPL_DATASYNCEXACT_H_
+#define SRC_IMPL_DATASYNCEXACT_H_
+
+// Exact policy of DataSync, instantiated by the generated
+// DataSyncExact*.cpp files (see src/impl/DataSync.cpp.in).
+
+#include <rtabmap_ros/DataSync.h>
+#include <message_filters/synchronizer.h>
+#include <message_filters/sync_policies/exact_time.h>
+
+namespace rtabmap_ros {
+
+template<typename... Ms>
+std::shared_ptr<void> ExactDataSync<Ms...>::create(
+		uint32_t queueSize,
+		const DataSyncCallback<Ms...> & callback,
+		message_filters::SimpleFilter<Ms> &... subs)
+{
+	typedef message_filters::sync_policies::ExactTime<Ms...> Policy;
+	std::shared_ptr<message_filters::Synchronizer<Policy> > sync(
+			new message_filters::Synchronizer<Policy>(Policy(queueSize), subs...));
+	sync->registerCallback(bindDataSyncCallback(callback, std::index_sequence_for<Ms...>()));
+	return sync;
+}
+
+}
+
+#endif /* SRC_IMPL_DATASYNCEXACT_H_ */
@@ -0,0 +1,278 @@
+/*
+Copyright (c) 2010-2016, Mathieu Labbe - IntRoLab - Universite de Sherbrooke
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Universite de Sherbrooke nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// Combinations of topics synchronized by CommonDataSubscriber, one per
+// DATA_SYNCS declaration of CommonDataSubscriber.h, grouped by the
+// CommonDataSubscriber*.cpp family setting them up. Each generated
+// DataSync<Policy><Family>.cpp (see src/impl/DataSync.cpp.in) defines the
+// macro of its family to instantiate its synchronizers, the other families
+// are ignored. A missing combination is a link error.
+
+#include <sensor_msgs/msg/image.hpp>
+#include <sensor_msgs/msg/camera_info.hpp>
+#include <sensor_msgs/msg/laser_scan.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <nav_msgs/msg/odometry.hpp>
+#include <rtabmap_ros/msg/rgbd_image.hpp>
+#include <rtabmap_ros/msg/user_data.hpp>
+#include <rtabmap_ros/msg/odom_info.hpp>
+
+#ifndef RTABMAP_DATA_SYNC_DEPTH
+#define RTABMAP_DATA_SYNC_DEPTH(...)
+#endif
+#ifndef RTABMAP_DATA_SYNC_STEREO
+#define RTABMAP_DATA_SYNC_STEREO(...)
+#endif
+#ifndef RTABMAP_DATA_SYNC_RGB
+#define RTABMAP_DATA_SYNC_RGB(...)
+#endif
+#ifndef RTABMAP_DATA_SYNC_RGBD
+#define RTABMAP_DATA_SYNC_RGBD(...)
+#endif
+#ifndef RTABMAP_DATA_SYNC_RGBD2
+#define RTABMAP_DATA_SYNC_RGBD2(...)
+#endif
+#ifndef RTABMAP_DATA_SYNC_RGBD3
+#define RTABMAP_DATA_SYNC_RGBD3(...)
+#endif
+#ifndef RTABMAP_DATA_SYNC_RGBD4
+#define RTABMAP_DATA_SYNC_RGBD4(...)
+#endif
+#ifndef RTABMAP_DATA_SYNC_SCAN
+#define RTABMAP_DATA_SYNC_SCAN(...)
+#endif
+#ifndef RTABMAP_DATA_SYNC_ODOM
+#define RTABMAP_DATA_SYNC_ODOM(...)
+#endif
+
+// Depth
+RTABMAP_DATA_SYNC_DEPTH(sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo) // depth
+RTABMAP_DATA_SYNC_DEPTH(sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan) // depthScan2d
+RTABMAP_DATA_SYNC_DEPTH(sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2) // depthScan3d
+RTABMAP_DATA_SYNC_DEPTH(sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // depthInfo
+RTABMAP_DATA_SYNC_DEPTH(sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // depthScan2dInfo
+RTABMAP_DATA_SYNC_DEPTH(sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // depthScan3dInfo
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo) // depthOdom
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan) // depthOdomScan2d
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2) // depthOdomScan3d
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // depthOdomInfo
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // depthOdomScan2dInfo
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // depthOdomScan3dInfo
+#ifdef RTABMAP_SYNC_USER_DATA
+RTABMAP_DATA_SYNC_DEPTH(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo) // depthData
+RTABMAP_DATA_SYNC_DEPTH(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan) // depthDataScan2d
+RTABMAP_DATA_SYNC_DEPTH(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2) // depthDataScan3d
+RTABMAP_DATA_SYNC_DEPTH(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // depthDataInfo
+RTABMAP_DATA_SYNC_DEPTH(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // depthDataScan2dInfo
+RTABMAP_DATA_SYNC_DEPTH(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // depthDataScan3dInfo
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo) // depthOdomData
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan) // depthOdomDataScan2d
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2) // depthOdomDataScan3d
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // depthOdomDataInfo
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // depthOdomDataScan2dInfo
+RTABMAP_DATA_SYNC_DEPTH(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // depthOdomDataScan3dInfo
+#endif
+
+// Stereo
+RTABMAP_DATA_SYNC_STEREO(sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::CameraInfo) // stereo
+RTABMAP_DATA_SYNC_STEREO(sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // stereoInfo
+RTABMAP_DATA_SYNC_STEREO(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::CameraInfo) // stereoOdom
+RTABMAP_DATA_SYNC_STEREO(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // stereoOdomInfo
+
+// RGB
+RTABMAP_DATA_SYNC_RGB(sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo) // rgb
+RTABMAP_DATA_SYNC_RGB(sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan) // rgbScan2d
+RTABMAP_DATA_SYNC_RGB(sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2) // rgbScan3d
+RTABMAP_DATA_SYNC_RGB(sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // rgbInfo
+RTABMAP_DATA_SYNC_RGB(sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbScan2dInfo
+RTABMAP_DATA_SYNC_RGB(sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbScan3dInfo
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo) // rgbOdom
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan) // rgbOdomScan2d
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2) // rgbOdomScan3d
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // rgbOdomInfo
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbOdomScan2dInfo
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbOdomScan3dInfo
+#ifdef RTABMAP_SYNC_USER_DATA
+RTABMAP_DATA_SYNC_RGB(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo) // rgbData
+RTABMAP_DATA_SYNC_RGB(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan) // rgbDataScan2d
+RTABMAP_DATA_SYNC_RGB(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2) // rgbDataScan3d
+RTABMAP_DATA_SYNC_RGB(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // rgbDataInfo
+RTABMAP_DATA_SYNC_RGB(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbDataScan2dInfo
+RTABMAP_DATA_SYNC_RGB(rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbDataScan3dInfo
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo) // rgbOdomData
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan) // rgbOdomDataScan2d
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2) // rgbOdomDataScan3d
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, rtabmap_ros::msg::OdomInfo) // rgbOdomDataInfo
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbOdomDataScan2dInfo
+RTABMAP_DATA_SYNC_RGB(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::Image, sensor_msgs::msg::CameraInfo, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbOdomDataScan3dInfo
+#endif
+
+// 1 RGBD
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbdScan2d
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbdScan3d
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbdInfo
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbdScan2dInfo
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbdScan3dInfo
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage) // rgbdOdom
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbdOdomScan2d
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbdOdomScan3d
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbdOdomInfo
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbdOdomScan2dInfo
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbdOdomScan3dInfo
+#ifdef RTABMAP_SYNC_USER_DATA
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage) // rgbdData
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbdDataScan2d
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbdDataScan3d
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbdDataInfo
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbdDataScan2dInfo
+RTABMAP_DATA_SYNC_RGBD(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbdDataScan3dInfo
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage) // rgbdOdomData
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbdOdomDataScan2d
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbdOdomDataScan3d
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbdOdomDataInfo
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbdOdomDataScan2dInfo
+RTABMAP_DATA_SYNC_RGBD(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbdOdomDataScan3dInfo
+#endif
+
+// 2 RGBD
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd2
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd2Scan2d
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd2Scan3d
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd2Info
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd2Scan2dInfo
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd2Scan3dInfo
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd2Odom
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd2OdomScan2d
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd2OdomScan3d
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd2OdomInfo
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd2OdomScan2dInfo
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd2OdomScan3dInfo
+#ifdef RTABMAP_SYNC_USER_DATA
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd2Data
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd2DataScan2d
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd2DataScan3d
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd2DataInfo
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd2DataScan2dInfo
+RTABMAP_DATA_SYNC_RGBD2(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd2DataScan3dInfo
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd2OdomData
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd2OdomDataScan2d
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd2OdomDataScan3d
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd2OdomDataInfo
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd2OdomDataScan2dInfo
+RTABMAP_DATA_SYNC_RGBD2(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd2OdomDataScan3dInfo
+#endif
+
+// 3 RGBD
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd3
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd3Scan2d
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd3Scan3d
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd3Info
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd3Scan2dInfo
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd3Scan3dInfo
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd3Odom
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd3OdomScan2d
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd3OdomScan3d
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd3OdomInfo
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd3OdomScan2dInfo
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd3OdomScan3dInfo
+#ifdef RTABMAP_SYNC_USER_DATA
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd3Data
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd3DataScan2d
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd3DataScan3d
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd3DataInfo
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd3DataScan2dInfo
+RTABMAP_DATA_SYNC_RGBD3(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd3DataScan3dInfo
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd3OdomData
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd3OdomDataScan2d
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd3OdomDataScan3d
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd3OdomDataInfo
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd3OdomDataScan2dInfo
+RTABMAP_DATA_SYNC_RGBD3(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd3OdomDataScan3dInfo
+#endif
+
+// 4 RGBD
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd4
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd4Scan2d
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd4Scan3d
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd4Info
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd4Scan2dInfo
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd4Scan3dInfo
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd4Odom
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd4OdomScan2d
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd4OdomScan3d
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd4OdomInfo
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd4OdomScan2dInfo
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd4OdomScan3dInfo
+#ifdef RTABMAP_SYNC_USER_DATA
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd4Data
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd4DataScan2d
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd4DataScan3d
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd4DataInfo
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd4DataScan2dInfo
+RTABMAP_DATA_SYNC_RGBD4(rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd4DataScan3dInfo
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage) // rgbd4OdomData
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan) // rgbd4OdomDataScan2d
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2) // rgbd4OdomDataScan3d
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::OdomInfo) // rgbd4OdomDataInfo
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // rgbd4OdomDataScan2dInfo
+RTABMAP_DATA_SYNC_RGBD4(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, rtabmap_ros::msg::RGBDImage, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // rgbd4OdomDataScan3dInfo
+#endif
+
+// Scan
+RTABMAP_DATA_SYNC_SCAN(sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // scan2dInfo
+RTABMAP_DATA_SYNC_SCAN(sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // scan3dInfo
+RTABMAP_DATA_SYNC_SCAN(nav_msgs::msg::Odometry, sensor_msgs::msg::LaserScan) // odomScan2d
+RTABMAP_DATA_SYNC_SCAN(nav_msgs::msg::Odometry, sensor_msgs::msg::PointCloud2) // odomScan3d
+RTABMAP_DATA_SYNC_SCAN(nav_msgs::msg::Odometry, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // odomScan2dInfo
+RTABMAP_DATA_SYNC_SCAN(nav_msgs::msg::Odometry, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // odomScan3dInfo
+#ifdef RTABMAP_SYNC_USER_DATA
+RTABMAP_DATA_SYNC_SCAN(rtabmap_ros::msg::UserData, sensor_msgs::msg::LaserScan) // dataScan2d
+RTABMAP_DATA_SYNC_SCAN(rtabmap_ros::msg::UserData, sensor_msgs::msg::PointCloud2) // dataScan3d
+RTABMAP_DATA_SYNC_SCAN(rtabmap_ros::msg::UserData, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // dataScan2dInfo
+RTABMAP_DATA_SYNC_SCAN(rtabmap_ros::msg::UserData, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // dataScan3dInfo
+RTABMAP_DATA_SYNC_SCAN(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::LaserScan) // odomDataScan2d
+RTABMAP_DATA_SYNC_SCAN(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::PointCloud2) // odomDataScan3d
+RTABMAP_DATA_SYNC_SCAN(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::LaserScan, rtabmap_ros::msg::OdomInfo) // odomDataScan2dInfo
+RTABMAP_DATA_SYNC_SCAN(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, sensor_msgs::msg::PointCloud2, rtabmap_ros::msg::OdomInfo) // odomDataScan3dInfo
+#endif
+
+// Odom
+RTABMAP_DATA_SYNC_ODOM(nav_msgs::msg::Odometry, rtabmap_ros::msg::OdomInfo) // odomInfo
+#ifdef RTABMAP_SYNC_USER_DATA
+RTABMAP_DATA_SYNC_ODOM(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData) // odomData
+RTABMAP_DATA_SYNC_ODOM(nav_msgs::msg::Odometry, rtabmap_ros::msg::UserData, rtabmap_ros::msg::OdomInfo) // odomDataInfo
+#endif
+
+#undef RTABMAP_DATA_SYNC_DEPTH
+#undef RTABMAP_DATA_SYNC_STEREO
+#undef RTABMAP_DATA_SYNC_RGB
+#undef RTABMAP_DATA_SYNC_RGBD
+#undef RTABMAP_DATA_SYNC_RGBD2
+#undef RTABMAP_DATA_SYNC_RGBD3
+#undef RTABMAP_DATA_SYNC_RGBD4
+#undef RTABMAP_DATA_SYNC_SCAN
+#undef RTABMAP_DATA_SYNC_ODOM
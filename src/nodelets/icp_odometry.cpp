@@ -231,80 +231,112 @@ void ICPOdometry::updateParameters(ParametersMap & parameters)
 
 void ICPOdometry::callbackScan(const sensor_msgs::msg::LaserScan::SharedPtr scanMsg)
 {
+	callbackCalled();
 	if(this->isPaused())
 	{
 		return;
 	}
 
 	// make sure the frame of the laser is updated too
-	Transform localScanTransform = getTransform(this->frameId(),
+	Transform localScanTransform = lookupTransform(this->frameId(),
 			scanMsg->header.frame_id,
-			rclcpp::Time(scanMsg->header.stamp.sec, scanMsg->header.stamp.nanosec) + rclcpp::Duration(scanMsg->ranges.size()*scanMsg->time_increment*10e9),
-			tfBuffer(), waitForTransform());
+			rclcpp::Time(scanMsg->header.stamp.sec, scanMsg->header.stamp.nanosec) + rclcpp::Duration(scanMsg->ranges.size()*scanMsg->time_increment*10e9));
 	if(localScanTransform.isNull())
 	{
 		RCLCPP_ERROR(this->get_logger(), "TF of received laser scan topic at time %fs is not set, aborting odometry update.", timestampFromROS(scanMsg->header.stamp));
 		return;
 	}
 
-	//transform in frameId_ frame
-	sensor_msgs::msg::PointCloud2 scanOut;
-	laser_geometry::LaserProjection projection;
-	projection.transformLaserScanToPointCloud(scanMsg->header.frame_id, *scanMsg, scanOut, this->tfBuffer());
-	pcl::PointCloud<pcl::PointXYZ>::Ptr pclScan(new pcl::PointCloud<pcl::PointXYZ>);
-	pcl::fromROSMsg(scanOut, *pclScan);
-	pclScan->is_dense = true;
-
 	cv::Mat scan;
 	int maxLaserScans = (int)scanMsg->ranges.size();
-	if(pclScan->size())
+	if(scanVoxelSize_ <= 0.0f)
 	{
+		// Project directly the beams, the scan stays organized
+		scan = scanConverter_.convert(*scanMsg, scanDownsamplingStep_, scanRangeMin_, scanRangeMax_, scanNormalK_, scanNormalRadius_);
 		if(scanDownsamplingStep_ > 1)
 		{
-			pclScan = util3d::downsample(pclScan, scanDownsamplingStep_);
 			maxLaserScans /= scanDownsamplingStep_;
 		}
-		if(scanVoxelSize_ > 0.0f)
+
+		if(!scan.empty() && filtered_scan_pub_->get_subscription_count())
 		{
-			float pointsBeforeFiltering = (float)pclScan->size();
-			pclScan = util3d::voxelize(pclScan, scanVoxelSize_);
-			float ratio = float(pclScan->size()) / pointsBeforeFiltering;
-			maxLaserScans = int(float(maxLaserScans) * ratio);
+			sensor_msgs::msg::PointCloud2::UniquePtr msg(new sensor_msgs::msg::PointCloud2);
+			rtabmap_ros::laserScanToROS(LaserScan::backwardCompatibility(scan), *msg);
+			msg->header = scanMsg->header;
+			filtered_scan_pub_->publish(std::move(msg));
 		}
-		if(scanNormalK_ > 0 || scanNormalRadius_>0.0f)
+	}
+	else
+	{
+		//transform in frameId_ frame, voxelized scan is not organized anymore
+		sensor_msgs::msg::PointCloud2 scanOut;
+		laser_geometry::LaserProjection projection;
+		projection.transformLaserScanToPointCloud(scanMsg->header.frame_id, *scanMsg, scanOut, this->tfBuffer());
+		pcl::PointCloud<pcl::PointXYZ>::Ptr pclScan(new pcl::PointCloud<pcl::PointXYZ>);
+		pcl::fromROSMsg(scanOut, *pclScan);
+		pclScan->is_dense = true;
+
+		if(pclScan->size() && (scanRangeMin_ > 0.0f || scanRangeMax_ > 0.0f))
 		{
-			//compute normals
-			pcl::PointCloud<pcl::Normal>::Ptr normals;
-			if(scanVoxelSize_ > 0.0f)
-			{
-				normals = util3d::computeNormals2D(pclScan, scanNormalK_, scanNormalRadius_);
-			}
-			else
+			// same range filtering than the direct projection above
+			pcl::PointCloud<pcl::PointXYZ>::Ptr filtered(new pcl::PointCloud<pcl::PointXYZ>);
+			filtered->reserve(pclScan->size());
+			float rangeMinSqr = scanRangeMin_*scanRangeMin_;
+			float rangeMaxSqr = scanRangeMax_*scanRangeMax_;
+			for(size_t i=0; i<pclScan->size(); ++i)
 			{
-				normals = util3d::computeFastOrganizedNormals2D(pclScan, scanNormalK_, scanNormalRadius_);
+				const pcl::PointXYZ & pt = pclScan->at(i);
+				float rangeSqr = pt.x*pt.x + pt.y*pt.y + pt.z*pt.z;
+				if((scanRangeMin_ <= 0.0f || rangeSqr >= rangeMinSqr) &&
+				   (scanRangeMax_ <= 0.0f || rangeSqr <= rangeMaxSqr))
+				{
+					filtered->push_back(pt);
+				}
 			}
-			pcl::PointCloud<pcl::PointNormal>::Ptr pclScanNormal(new pcl::PointCloud<pcl::PointNormal>);
-			pcl::concatenateFields(*pclScan, *normals, *pclScanNormal);
-			scan = util3d::laserScan2dFromPointCloud(*pclScanNormal).data();
+			filtered->header = pclScan->header;
+			filtered->is_dense = true;
+			pclScan = filtered;
+		}
 
-			if(filtered_scan_pub_->get_subscription_count())
+		if(pclScan->size())
+		{
+			if(scanDownsamplingStep_ > 1)
 			{
-				sensor_msgs::msg::PointCloud2::UniquePtr msg(new sensor_msgs::msg::PointCloud2);
-				pcl::toROSMsg(*pclScanNormal, *msg);
-				msg->header = scanMsg->header;
-				filtered_scan_pub_->publish(std::move(msg));
+				pclScan = util3d::downsample(pclScan, scanDownsamplingStep_);
+				maxLaserScans /= scanDownsamplingStep_;
 			}
-		}
-		else
-		{
-			scan = util3d::laserScan2dFromPointCloud(*pclScan).data();
+			float pointsBeforeFiltering = (float)pclScan->size();
+			pclScan = util3d::voxelize(pclScan, scanVoxelSize_);
+			float ratio = float(pclScan->size()) / pointsBeforeFiltering;
+			maxLaserScans = int(float(maxLaserScans) * ratio);
+			if(scanNormalK_ > 0 || scanNormalRadius_>0.0f)
+			{
+				//compute normals
+				pcl::PointCloud<pcl::Normal>::Ptr normals = util3d::computeNormals2D(pclScan, scanNormalK_, scanNormalRadius_);
+				pcl::PointCloud<pcl::PointNormal>::Ptr pclScanNormal(new pcl::PointCloud<pcl::PointNormal>);
+				pcl::concatenateFields(*pclScan, *normals, *pclScanNormal);
+				pclScanNormal = util3d::removeNaNNormalsFromPointCloud(pclScanNormal);
+				scan = util3d::laserScan2dFromPointCloud(*pclScanNormal).data();
 
-			if(filtered_scan_pub_->get_subscription_count())
+				if(filtered_scan_pub_->get_subscription_count())
+				{
+					sensor_msgs::msg::PointCloud2::UniquePtr msg(new sensor_msgs::msg::PointCloud2);
+					pcl::toROSMsg(*pclScanNormal, *msg);
+					msg->header = scanMsg->header;
+					filtered_scan_pub_->publish(std::move(msg));
+				}
+			}
+			else
 			{
-				sensor_msgs::msg::PointCloud2::UniquePtr msg(new sensor_msgs::msg::PointCloud2);
-				pcl::toROSMsg(*pclScan, *msg);
-				msg->header = scanMsg->header;
-				filtered_scan_pub_->publish(std::move(msg));
+				scan = util3d::laserScan2dFromPointCloud(*pclScan).data();
+
+				if(filtered_scan_pub_->get_subscription_count())
+				{
+					sensor_msgs::msg::PointCloud2::UniquePtr msg(new sensor_msgs::msg::PointCloud2);
+					pcl::toROSMsg(*pclScan, *msg);
+					msg->header = scanMsg->header;
+					filtered_scan_pub_->publish(std::move(msg));
+				}
 			}
 		}
 	}
@@ -322,36 +354,14 @@ void ICPOdometry::callbackScan(const sensor_msgs::msg::LaserScan::SharedPtr scan
 
 void ICPOdometry::callbackCloud(const sensor_msgs::msg::PointCloud2::SharedPtr pointCloudMsg)
 {
+	callbackCalled();
 	if(this->isPaused())
 	{
 		return;
 	}
 
-	sensor_msgs::msg::PointCloud2 cloudMsg;
-	/*if (!plugins_.empty())
-	{
-		if (plugins_[0]->isEnabled())
-		{
-			cloudMsg = plugins_[0]->filterPointCloud(*pointCloudMsg);
-		}
-		else
-		{
-			cloudMsg = *pointCloudMsg;
-		}
-
-		if (plugins_.size() > 1)
-		{
-			for (int i = 1; i < plugins_.size(); i++) {
-				if (plugins_[i]->isEnabled()) {
-					cloudMsg = plugins_[i]->filterPointCloud(cloudMsg);
-				}
-			}
-		}
-	}
-	else*/
-	{
-	cloudMsg = *pointCloudMsg;
-	}
+	// no copy, plugins are not supported
+	const sensor_msgs::msg::PointCloud2 & cloudMsg = *pointCloudMsg;
 
 	cv::Mat scan;
 	bool containNormals = false;
@@ -367,7 +377,7 @@ void ICPOdometry::callbackCloud(const sensor_msgs::msg::PointCloud2::SharedPtr p
 		}
 	}
 
-	Transform localScanTransform = getTransform(this->frameId(), cloudMsg.header.frame_id, cloudMsg.header.stamp, tfBuffer(), waitForTransform());
+	Transform localScanTransform = lookupTransform(this->frameId(), cloudMsg.header.frame_id, cloudMsg.header.stamp);
 	if(localScanTransform.isNull())
 	{
 		RCLCPP_ERROR(this->get_logger(), "TF of received scan cloud at time %fs is not set, aborting rtabmap update.", timestampFromROS(cloudMsg.header.stamp));
@@ -381,7 +391,24 @@ void ICPOdometry::callbackCloud(const sensor_msgs::msg::PointCloud2::SharedPtr p
 				scanCloudMaxPoints_, cloudMsg.width, cloudMsg.height);
 	}
 	int maxLaserScans = scanCloudMaxPoints_;
-	if(containNormals)
+	LaserScan laserScan;
+	bool directRead = scanVoxelSize_ == 0.0f &&
+	   (containNormals || (scanNormalK_ <= 0 && scanNormalRadius_<=0.0f)) &&
+	   laserScanFromPointCloud2(cloudMsg, laserScan, localScanTransform,
+			   scanDownsamplingStep_>1?maxLaserScans/scanDownsamplingStep_:maxLaserScans, 0,
+			   scanRangeMin_, scanRangeMax_, scanDownsamplingStep_);
+	if(directRead)
+	{
+		// Read directly from the message buffer, already range filtered
+		if(!laserScan.isEmpty() && filtered_scan_pub_->get_subscription_count())
+		{
+			sensor_msgs::msg::PointCloud2::UniquePtr msg(new sensor_msgs::msg::PointCloud2);
+			rtabmap_ros::laserScanToROS(laserScan, *msg);
+			msg->header = cloudMsg.header;
+			filtered_scan_pub_->publish(std::move(msg));
+		}
+	}
+	else if(containNormals)
 	{
 		pcl::PointCloud<pcl::PointNormal>::Ptr pclScan(new pcl::PointCloud<pcl::PointNormal>);
 		pcl::fromROSMsg(cloudMsg, *pclScan);
@@ -428,6 +455,7 @@ void ICPOdometry::callbackCloud(const sensor_msgs::msg::PointCloud2::SharedPtr p
 				pcl::PointCloud<pcl::Normal>::Ptr normals = util3d::computeNormals(pclScan, scanNormalK_, scanNormalRadius_);
 				pcl::PointCloud<pcl::PointNormal>::Ptr pclScanNormal(new pcl::PointCloud<pcl::PointNormal>);
 				pcl::concatenateFields(*pclScan, *normals, *pclScanNormal);
+				pclScanNormal = util3d::removeNaNNormalsFromPointCloud(pclScanNormal);
 				scan = util3d::laserScanFromPointCloud(*pclScanNormal).data();
 
 				if(filtered_scan_pub_->get_subscription_count())
@@ -453,10 +481,14 @@ void ICPOdometry::callbackCloud(const sensor_msgs::msg::PointCloud2::SharedPtr p
 		}
 	}
 
-	LaserScan laserScan = LaserScan::backwardCompatibility(scan, maxLaserScans, 0, localScanTransform);
-	if(scanRangeMin_ > 0 || scanRangeMax_ > 0)
+	if(!directRead)
 	{
-		laserScan = util3d::rangeFiltering(laserScan, scanRangeMin_, scanRangeMax_);
+		// pcl paths above only fill scan
+		laserScan = LaserScan::backwardCompatibility(scan, maxLaserScans, 0, localScanTransform);
+		if(scanRangeMin_ > 0 || scanRangeMax_ > 0)
+		{
+			laserScan = util3d::rangeFiltering(laserScan, scanRangeMin_, scanRangeMax_);
+		}
 	}
 
 	rtabmap::SensorData data(
@@ -209,81 +209,125 @@ void PointCloudAggregator::combineClouds(const std::vector<sensor_msgs::msg::Poi
 	UASSERT(cloudMsgs.size() > 1);
 	if(cloudPub_->get_subscription_count())
 	{
-		pcl::PCLPointCloud2 output;
+		std::string frameId = frameId_.empty()?cloudMsgs[0]->header.frame_id:frameId_;
 
-		std::string frameId = frameId_;
-		if(!frameId.empty() && frameId.compare(cloudMsgs[0]->header.frame_id) != 0)
+		// Fuse extrinsics and displacement (approx sync) in one transform per cloud
+		std::vector<rtabmap::Transform> transforms(cloudMsgs.size());
+		size_t totalPoints = 0;
+		bool sameLayout = true;
+		bool isDense = true;
+		for(unsigned int i=0; i<cloudMsgs.size(); ++i)
 		{
-			sensor_msgs::msg::PointCloud2 tmp;
-			rtabmap::Transform t = rtabmap_ros::getTransform(frameId, cloudMsgs[0]->header.frame_id, cloudMsgs[0]->header.stamp, *tfBuffer_, 0.1);
-			if(t.isNull())
+			if(frameId.compare(cloudMsgs[i]->header.frame_id) != 0)
 			{
-				return;
+				transforms[i] = rtabmap_ros::getTransform(frameId, cloudMsgs[i]->header.frame_id, cloudMsgs[i]->header.stamp, *tfBuffer_, 0.1);
+				if(transforms[i].isNull())
+				{
+					return;
+				}
 			}
-			rtabmap_ros::transformPointCloud(t.toEigen4f(), *cloudMsgs[0], tmp);
-			pcl_conversions::toPCL(tmp, output);
-		}
-		else
-		{
-			pcl_conversions::toPCL(*cloudMsgs[0], output);
-			frameId = cloudMsgs[0]->header.frame_id;
-		}
-
-		for(unsigned int i=1; i<cloudMsgs.size(); ++i)
-		{
-			rtabmap::Transform cloudDisplacement;
-			if(!fixedFrameId_.empty() &&
+			if(i>0 &&
+			   !fixedFrameId_.empty() &&
 			   cloudMsgs[0]->header.stamp != cloudMsgs[i]->header.stamp)
 			{
 				// approx sync
-				cloudDisplacement = rtabmap_ros::getTransform(
+				rtabmap::Transform cloudDisplacement = rtabmap_ros::getTransform(
 						frameId, //sourceTargetFrame
 						fixedFrameId_, //fixedFrame
 						cloudMsgs[i]->header.stamp, //stampSource
 						cloudMsgs[0]->header.stamp, //stampTarget
 						*tfBuffer_,
 						0.1);
+				if(!cloudDisplacement.isNull())
+				{
+					transforms[i] = transforms[i].isNull()?cloudDisplacement:cloudDisplacement * transforms[i];
+				}
 			}
+			totalPoints += (size_t)cloudMsgs[i]->width * cloudMsgs[i]->height;
+			isDense = isDense && cloudMsgs[i]->is_dense;
+			sameLayout = sameLayout &&
+					cloudMsgs[i]->point_step == cloudMsgs[0]->point_step &&
+					cloudMsgs[i]->is_bigendian == cloudMsgs[0]->is_bigendian &&
+					cloudMsgs[i]->fields == cloudMsgs[0]->fields;
+		}
 
-			pcl::PCLPointCloud2 cloud2;
-			if(frameId.compare(cloudMsgs[i]->header.frame_id) != 0)
+		sensor_msgs::msg::PointCloud2::UniquePtr rosCloud(new sensor_msgs::msg::PointCloud2);
+		if(sameLayout)
+		{
+			// Single pass: each cloud is copied once in its slot of the output, then transformed in place
+			rosCloud->fields = cloudMsgs[0]->fields;
+			rosCloud->is_bigendian = cloudMsgs[0]->is_bigendian;
+			rosCloud->point_step = cloudMsgs[0]->point_step;
+			rosCloud->height = 1;
+			rosCloud->width = totalPoints;
+			rosCloud->row_step = rosCloud->width * rosCloud->point_step;
+			rosCloud->is_dense = isDense;
+			rosCloud->data.resize(rosCloud->row_step);
+
+			size_t offset = 0; // points
+			for(unsigned int i=0; i<cloudMsgs.size(); ++i)
 			{
-				sensor_msgs::msg::PointCloud2 tmp;
-				rtabmap::Transform t = rtabmap_ros::getTransform(frameId, cloudMsgs[i]->header.frame_id, cloudMsgs[i]->header.stamp, *tfBuffer_, 0.1);
-				rtabmap_ros::transformPointCloud(t.toEigen4f(), *cloudMsgs[i], tmp);
-				if(!cloudDisplacement.isNull())
+				const sensor_msgs::msg::PointCloud2 & cloud = *cloudMsgs[i];
+				size_t rowSize = (size_t)cloud.width * cloud.point_step;
+				size_t points = (size_t)cloud.width * cloud.height;
+				unsigned char * dst = rosCloud->data.data() + offset * rosCloud->point_step;
+				if(cloud.row_step == rowSize)
 				{
-					sensor_msgs::msg::PointCloud2 tmp2;
-					rtabmap_ros::transformPointCloud(cloudDisplacement.toEigen4f(), tmp, tmp2);
-					pcl_conversions::toPCL(tmp2, cloud2);
+					memcpy(dst, cloud.data.data(), rowSize * cloud.height);
 				}
 				else
 				{
-					pcl_conversions::toPCL(tmp, cloud2);
+					// padded rows
+					for(unsigned int r=0; r<cloud.height; ++r)
+					{
+						memcpy(dst + r*rowSize, cloud.data.data() + r*cloud.row_step, rowSize);
+					}
 				}
-
+				if(!transforms[i].isNull())
+				{
+					rtabmap_ros::transformPointCloudPoints(transforms[i].toEigen4f(), *rosCloud, offset, offset + points);
+				}
+				offset += points;
 			}
-			else
+		}
+		else
+		{
+			static bool warned = false;
+			if(!warned)
 			{
-				if(!cloudDisplacement.isNull())
+				warned = true;
+				RCLCPP_WARN(this->get_logger(), "Input clouds don't have the same fields, "
+						"they will be concatenated with common fields only (slower). This message is only shown once.");
+			}
+			pcl::PCLPointCloud2 output;
+			for(unsigned int i=0; i<cloudMsgs.size(); ++i)
+			{
+				pcl::PCLPointCloud2 cloud2;
+				if(!transforms[i].isNull())
 				{
 					sensor_msgs::msg::PointCloud2 tmp;
-					rtabmap_ros::transformPointCloud(cloudDisplacement.toEigen4f(), *cloudMsgs[i], tmp);
-					pcl_conversions::toPCL(tmp, cloud2);
+					rtabmap_ros::transformPointCloud(transforms[i].toEigen4f(), *cloudMsgs[i], tmp);
+					pcl_conversions::moveToPCL(tmp, cloud2);
 				}
 				else
 				{
 					pcl_conversions::toPCL(*cloudMsgs[i], cloud2);
 				}
-			}
 
-			pcl::PCLPointCloud2 tmp_output;
-			pcl::concatenatePointCloud(output, cloud2, tmp_output);
-			output = tmp_output;
+				if(i==0)
+				{
+					output = std::move(cloud2);
+				}
+				else
+				{
+					pcl::PCLPointCloud2 tmp_output;
+					pcl::concatenatePointCloud(output, cloud2, tmp_output);
+					output = std::move(tmp_output);
+				}
+			}
+			pcl_conversions::moveFromPCL(output, *rosCloud);
 		}
 
-		sensor_msgs::msg::PointCloud2::UniquePtr rosCloud(new sensor_msgs::msg::PointCloud2);
-		pcl_conversions::moveFromPCL(output, *rosCloud);
 		rosCloud->header.stamp = cloudMsgs[0]->header.stamp;
 		rosCloud->header.frame_id = frameId;
 		cloudPub_->publish(std::move(rosCloud));
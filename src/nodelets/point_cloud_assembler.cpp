@@ -53,7 +53,10 @@ PointCloudAssembler::PointCloudAssembler(const rclcpp::NodeOptions & options) :
 	rangeMin_(0),
 	rangeMax_(0),
 	voxelSize_(0),
-	fixedFrameId_("odom")
+	fixedFrameId_("odom"),
+	incremental_(false),
+	incrementalClouds_(0),
+	incrementalPointStep_(0)
 {
 	tfBuffer_ = std::make_shared<tf2_ros::Buffer>(this->get_clock());
 	//auto timer_interface = std::make_shared<tf2_ros::CreateTimerROS>(
@@ -73,7 +76,13 @@ PointCloudAssembler::PointCloudAssembler(const rclcpp::NodeOptions & options) :
 	rangeMin_ = this->declare_parameter("range_min", rangeMin_);
 	rangeMax_ = this->declare_parameter("range_max", rangeMax_);
 	voxelSize_ = this->declare_parameter("voxel_size", voxelSize_);
+	incremental_ = this->declare_parameter("incremental", incremental_);
 	UASSERT(maxClouds_>0 || assemblingTime_ >0.0);
+	if(incremental_ && voxelSize_ <= 0.0)
+	{
+		RCLCPP_WARN(this->get_logger(), "Parameter \"incremental\" is true but \"voxel_size\" is not set, incremental assembling is disabled.");
+		incremental_ = false;
+	}
 
 	cloudsSkipped_ = skipClouds_;
 
@@ -147,6 +156,7 @@ void PointCloudAssembler::callbackCloudOdom(
 	{
 		RCLCPP_WARN(this->get_logger(), "Reseting point cloud assembler as null odometry has been received.");
 		clouds_.clear();
+		clearIncremental();
 	}
 }
 
@@ -158,6 +168,12 @@ void PointCloudAssembler::callbackCloud(const sensor_msgs::msg::PointCloud2::Con
 		{
 			cloudsSkipped_ = 0;
 
+			if(incremental_)
+			{
+				addCloudIncremental(cloudMsg);
+				return;
+			}
+
 			sensor_msgs::msg::PointCloud2::SharedPtr cpy(new sensor_msgs::msg::PointCloud2);
 			*cpy = *cloudMsg;
 			clouds_.push_back(cpy);
@@ -236,6 +252,142 @@ void PointCloudAssembler::callbackCloud(const sensor_msgs::msg::PointCloud2::Con
 	}
 }
 
+void PointCloudAssembler::clearIncremental()
+{
+	incrementalClouds_ = 0;
+	incrementalFields_.clear();
+	incrementalPointStep_ = 0;
+	voxelIndices_.clear();
+	voxelSums_.clear();
+	voxelCounts_.clear();
+	voxelData_.clear();
+}
+
+void PointCloudAssembler::addCloudIncremental(const sensor_msgs::msg::PointCloud2::ConstSharedPtr & cloudMsg)
+{
+	int xIdx = pcl::getFieldIndex(*cloudMsg, "x");
+	int yIdx = pcl::getFieldIndex(*cloudMsg, "y");
+	int zIdx = pcl::getFieldIndex(*cloudMsg, "z");
+	if(xIdx < 0 || yIdx < 0 || zIdx < 0 ||
+	   cloudMsg->fields[xIdx].datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+	   cloudMsg->fields[yIdx].datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+	   cloudMsg->fields[zIdx].datatype != sensor_msgs::msg::PointField::FLOAT32)
+	{
+		RCLCPP_ERROR(this->get_logger(), "Input cloud should have float x, y and z fields!");
+		return;
+	}
+
+	if(incrementalClouds_ > 0 &&
+	   (cloudMsg->fields != incrementalFields_ || cloudMsg->point_step != incrementalPointStep_))
+	{
+		RCLCPP_WARN(this->get_logger(), "Input cloud fields have changed! Resetting...");
+		clearIncremental();
+	}
+
+	// cloud in fixed frame
+	rtabmap::Transform t = rtabmap_ros::getTransform(
+			fixedFrameId_,
+			cloudMsg->header.frame_id,
+			cloudMsg->header.stamp,
+			*tfBuffer_,
+			waitForTransformDuration_);
+	if(t.isNull())
+	{
+		RCLCPP_ERROR(this->get_logger(), "Cloud not transform cloud in %s frame! Resetting...", fixedFrameId_.c_str());
+		clearIncremental();
+		return;
+	}
+
+	if(incrementalClouds_ == 0)
+	{
+		incrementalFirstStamp_ = cloudMsg->header.stamp;
+		incrementalFields_ = cloudMsg->fields;
+		incrementalPointStep_ = cloudMsg->point_step;
+	}
+	++incrementalClouds_;
+
+	const unsigned int xOffset = cloudMsg->fields[xIdx].offset;
+	const unsigned int yOffset = cloudMsg->fields[yIdx].offset;
+	const unsigned int zOffset = cloudMsg->fields[zIdx].offset;
+	const float rangeMinSqr = rangeMin_*rangeMin_;
+	const float rangeMaxSqr = rangeMax_*rangeMax_;
+	const float voxelSize = voxelSize_;
+	Eigen::Affine3f transform = t.toEigen3f();
+	for(unsigned int r=0; r<cloudMsg->height; ++r)
+	{
+		for(unsigned int c=0; c<cloudMsg->width; ++c)
+		{
+			const unsigned char * ptr = &cloudMsg->data[r*cloudMsg->row_step + c*cloudMsg->point_step];
+			Eigen::Vector3f pt;
+			memcpy(&pt[0], ptr + xOffset, sizeof(float));
+			memcpy(&pt[1], ptr + yOffset, sizeof(float));
+			memcpy(&pt[2], ptr + zOffset, sizeof(float));
+			if(!std::isfinite(pt[0]) || !std::isfinite(pt[1]) || !std::isfinite(pt[2]))
+			{
+				continue;
+			}
+			if(rangeMin_ > 0.0 || rangeMax_ > 0.0)
+			{
+				float rangeSqr = pt.squaredNorm();
+				if((rangeMin_ > 0.0 && rangeSqr < rangeMinSqr) ||
+				   (rangeMax_ > 0.0 && rangeSqr > rangeMaxSqr))
+				{
+					continue;
+				}
+			}
+			pt = transform * pt;
+
+			// 21 bits per axis
+			long long key =
+					((long long)((int)std::floor(pt[0]/voxelSize) & 0x1FFFFF) << 42) |
+					((long long)((int)std::floor(pt[1]/voxelSize) & 0x1FFFFF) << 21) |
+					(long long)((int)std::floor(pt[2]/voxelSize) & 0x1FFFFF);
+			std::pair<std::unordered_map<long long, int>::iterator, bool> inserted = voxelIndices_.insert(std::make_pair(key, (int)voxelCounts_.size()));
+			if(inserted.second)
+			{
+				voxelSums_.push_back(pt);
+				voxelCounts_.push_back(1);
+				voxelData_.insert(voxelData_.end(), ptr, ptr + cloudMsg->point_step);
+			}
+			else
+			{
+				voxelSums_[inserted.first->second] += pt;
+				++voxelCounts_[inserted.first->second];
+			}
+		}
+	}
+
+	if(  (incrementalClouds_ >= maxClouds_ && maxClouds_ > 0)
+		||
+		 (timestampFromROS(cloudMsg->header.stamp) >= timestampFromROS(incrementalFirstStamp_) + assemblingTime_ && assemblingTime_ > 0.0))
+	{
+		// voxels are in fixed frame, put them back in the frame of the latest cloud
+		rtabmap::Transform tInv = t.inverse();
+
+		sensor_msgs::msg::PointCloud2 rosCloud;
+		rosCloud.header = cloudMsg->header;
+		rosCloud.fields = incrementalFields_;
+		rosCloud.is_bigendian = cloudMsg->is_bigendian;
+		rosCloud.point_step = incrementalPointStep_;
+		rosCloud.height = 1;
+		rosCloud.width = voxelCounts_.size();
+		rosCloud.row_step = rosCloud.width * rosCloud.point_step;
+		rosCloud.is_dense = true;
+		rosCloud.data = std::move(voxelData_);
+		for(unsigned int i=0; i<voxelCounts_.size(); ++i)
+		{
+			Eigen::Vector3f centroid = voxelSums_[i] / float(voxelCounts_[i]);
+			unsigned char * ptr = &rosCloud.data[i*rosCloud.point_step];
+			memcpy(ptr + xOffset, &centroid[0], sizeof(float));
+			memcpy(ptr + yOffset, &centroid[1], sizeof(float));
+			memcpy(ptr + zOffset, &centroid[2], sizeof(float));
+		}
+		rtabmap_ros::transformPointCloudPoints(tInv.toEigen4f(), rosCloud, 0, rosCloud.width);
+		cloudPub_->publish(rosCloud);
+		clearIncremental();
+	}
+}
+
 }
 
 #include "rclcpp_components/register_node_macro.hpp"
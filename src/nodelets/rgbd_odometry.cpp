@@ -324,41 +324,26 @@ void RGBDOdometry::commonCallback(
 			higherStamp = stamp;
 		}
 
-		Transform localTransform = getTransform(this->frameId(), rgbImages[i]->header.frame_id, stamp, tfBuffer(), waitForTransform());
+		Transform localTransform = lookupTransform(this->frameId(), rgbImages[i]->header.frame_id, stamp);
 		if(localTransform.isNull())
 		{
 			return;
 		}
 
-		cv_bridge::CvImageConstPtr ptrImage = rgbImages[i];
-		if(rgbImages[i]->encoding.compare(sensor_msgs::image_encodings::TYPE_8UC1) !=0 &&
-		   rgbImages[i]->encoding.compare(sensor_msgs::image_encodings::MONO8) != 0)
-		{
-			ptrImage = cv_bridge::cvtColor(rgbImages[i], "mono8");
-		}
-
-		cv_bridge::CvImageConstPtr ptrDepth = depthImages[i];
-		cv::Mat subDepth = ptrDepth->image;
+		const cv::Mat & subDepth = depthImages[i]->image;
 
 		// initialize
 		if(rgb.empty())
 		{
-			rgb = cv::Mat(imageHeight, imageWidth*cameraCount, ptrImage->image.type());
+			rgb = imagePool_.acquire(imageHeight, imageWidth*cameraCount, CV_8UC1);
 		}
 		if(depth.empty())
 		{
-			depth = cv::Mat(depthHeight, depthWidth*cameraCount, subDepth.type());
+			depth = imagePool_.acquire(depthHeight, depthWidth*cameraCount, subDepth.type());
 		}
 
-		if(ptrImage->image.type() == rgb.type())
-		{
-			ptrImage->image.copyTo(cv::Mat(rgb, cv::Rect(i*imageWidth, 0, imageWidth, imageHeight)));
-		}
-		else
-		{
-			RCLCPP_ERROR(this->get_logger(), "Some RGB images are not the same type!");
-			return;
-		}
+		cv::Mat rgbRoi(rgb, cv::Rect(i*imageWidth, 0, imageWidth, imageHeight));
+		rtabmap_ros::cvtColorTo(rgbImages[i], sensor_msgs::image_encodings::MONO8, rgbRoi);
 
 		if(subDepth.type() == depth.type())
 		{
@@ -425,11 +410,10 @@ void RGBDOdometry::callbackRGBD2(
 	callbackCalled();
 	if(!this->isPaused())
 	{
-		std::vector<cv_bridge::CvImageConstPtr> imageMsgs(2);
-		std::vector<cv_bridge::CvImageConstPtr> depthMsgs(2);
+		std::vector<cv_bridge::CvImageConstPtr> imageMsgs;
+		std::vector<cv_bridge::CvImageConstPtr> depthMsgs;
 		std::vector<sensor_msgs::msg::CameraInfo> infoMsgs;
-		rtabmap_ros::toCvShare(image, imageMsgs[0], depthMsgs[0]);
-		rtabmap_ros::toCvShare(image2, imageMsgs[1], depthMsgs[1]);
+		rtabmap_ros::toCvShare({image, image2}, imageMsgs, depthMsgs);
 		infoMsgs.push_back(image->rgb_camera_info);
 		infoMsgs.push_back(image2->rgb_camera_info);
 
@@ -445,12 +429,10 @@ void RGBDOdometry::callbackRGBD3(
 	callbackCalled();
 	if(!this->isPaused())
 	{
-		std::vector<cv_bridge::CvImageConstPtr> imageMsgs(3);
-		std::vector<cv_bridge::CvImageConstPtr> depthMsgs(3);
+		std::vector<cv_bridge::CvImageConstPtr> imageMsgs;
+		std::vector<cv_bridge::CvImageConstPtr> depthMsgs;
 		std::vector<sensor_msgs::msg::CameraInfo> infoMsgs;
-		rtabmap_ros::toCvShare(image, imageMsgs[0], depthMsgs[0]);
-		rtabmap_ros::toCvShare(image2, imageMsgs[1], depthMsgs[1]);
-		rtabmap_ros::toCvShare(image3, imageMsgs[2], depthMsgs[2]);
+		rtabmap_ros::toCvShare({image, image2, image3}, imageMsgs, depthMsgs);
 		infoMsgs.push_back(image->rgb_camera_info);
 		infoMsgs.push_back(image2->rgb_camera_info);
 		infoMsgs.push_back(image3->rgb_camera_info);
@@ -468,13 +450,10 @@ void RGBDOdometry::callbackRGBD4(
 	callbackCalled();
 	if(!this->isPaused())
 	{
-		std::vector<cv_bridge::CvImageConstPtr> imageMsgs(4);
-		std::vector<cv_bridge::CvImageConstPtr> depthMsgs(4);
+		std::vector<cv_bridge::CvImageConstPtr> imageMsgs;
+		std::vector<cv_bridge::CvImageConstPtr> depthMsgs;
 		std::vector<sensor_msgs::msg::CameraInfo> infoMsgs;
-		rtabmap_ros::toCvShare(image, imageMsgs[0], depthMsgs[0]);
-		rtabmap_ros::toCvShare(image2, imageMsgs[1], depthMsgs[1]);
-		rtabmap_ros::toCvShare(image3, imageMsgs[2], depthMsgs[2]);
-		rtabmap_ros::toCvShare(image4, imageMsgs[3], depthMsgs[3]);
+		rtabmap_ros::toCvShare({image, image2, image3, image4}, imageMsgs, depthMsgs);
 		infoMsgs.push_back(image->rgb_camera_info);
 		infoMsgs.push_back(image2->rgb_camera_info);
 		infoMsgs.push_back(image3->rgb_camera_info);
@@ -36,6 +36,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <opencv2/highgui/highgui.hpp>
 
 #include "rtabmap_ros/MsgConversion.h"
+#include "rtabmap_ros/DepthCodec.h"
 
 #include "rtabmap/core/Compression.h"
 #include "rtabmap/utilite/UConversion.h"
@@ -46,10 +47,16 @@ namespace rtabmap_ros
 RGBDRelay::RGBDRelay(const rclcpp::NodeOptions & options) :
 	Node("rgbd_relay", options),
 	compress_(false),
-	uncompress_(false)
+	uncompress_(false),
+	depthCompression_("png")
 {
 	compress_ = this->declare_parameter("compress", compress_);
 	uncompress_ = this->declare_parameter("uncompress", uncompress_);
+	depthCompression_ = this->declare_parameter("depth_compression", depthCompression_);
+
+	RCLCPP_INFO(this->get_logger(), "%s: compress          = %s", get_name(), compress_?"true":"false");
+	RCLCPP_INFO(this->get_logger(), "%s: uncompress        = %s", get_name(), uncompress_?"true":"false");
+	RCLCPP_INFO(this->get_logger(), "%s: depth_compression = %s", get_name(), depthCompression_.c_str());
 
 	rgbdImageSub_ = create_subscription<rtabmap_ros::msg::RGBDImage>("rgbd_image", rclcpp::SensorDataQoS(), std::bind(&RGBDRelay::callback, this, std::placeholders::_1));
 	rgbdImagePub_ = create_publisher<rtabmap_ros::msg::RGBDImage>("rgbd_image_relay", 1);
@@ -103,21 +110,24 @@ void RGBDRelay::callback(const rtabmap_ros::msg::RGBDImage::SharedPtr input) con
 				{
 					// depth image
 					cv_bridge::CvImageConstPtr imageDepthPtr = cv_bridge::toCvShare(input->depth, input);
-					output->depth_compressed.data = rtabmap::compressImage(imageDepthPtr->image, ".png");
-					output->depth_compressed.format = "png";
+					output->depth_compressed.data = compressDepth(imageDepthPtr->image, depthCompression_, output->depth_compressed.format);
 				}
 			}
 		}
 		if(uncompress_)
 		{
+			// RGB and depth are decoded in parallel
+			cv_bridge::CvImageConstPtr rgb, depth;
+			rtabmap_ros::toCvShare(input, rgb, depth);
+
 			if(!input->rgb.data.empty())
 			{
 				// already raw, just copy pointer
 				output->rgb = input->rgb;
 			}
-			if(!input->rgb_compressed.data.empty())
+			else if(!input->rgb_compressed.data.empty())
 			{
-				cv_bridge::toCvCopy(input->rgb_compressed)->toImageMsg(output->rgb);
+				rgb->toImageMsg(output->rgb);
 			}
 
 			if(!input->depth.data.empty())
@@ -125,20 +135,9 @@ void RGBDRelay::callback(const rtabmap_ros::msg::RGBDImage::SharedPtr input) con
 				// already raw, just copy pointer
 				output->depth = input->depth;
 			}
-			else if(input->depth_compressed.format.compare("jpg")==0)
-			{
-				// right stereo image
-				cv_bridge::toCvCopy(input->depth_compressed)->toImageMsg(output->depth);
-			}
-			else
+			else if(!input->depth_compressed.data.empty())
 			{
-				// dpeth image
-				auto cvImg = std::make_unique<cv_bridge::CvImage>();
-				cvImg->header = input->depth_compressed.header;
-				cvImg->image = rtabmap::uncompressImage(input->depth_compressed.data);
-				UASSERT(cvImg->image.empty() || cvImg->image.type() == CV_32FC1 || cvImg->image.type() == CV_16UC1);
-				cvImg->encoding = cvImg->image.empty()?"":cvImg->image.type() == CV_32FC1?sensor_msgs::image_encodings::TYPE_32FC1:sensor_msgs::image_encodings::TYPE_16UC1;
-				cvImg->toImageMsg(output->depth);
+				depth->toImageMsg(output->depth);
 			}
 		}
 
@@ -36,6 +36,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "rtabmap/core/Compression.h"
 #include "rtabmap/utilite/UConversion.h"
 #include "rtabmap_ros/MsgConversion.h"
+#include "rtabmap_ros/DepthCodec.h"
 
 namespace rtabmap_ros
 {
@@ -44,24 +45,52 @@ RGBDSync::RGBDSync(const rclcpp::NodeOptions & options) :
 	Node("rgbd_sync", options),
 	depthScale_(1.0),
 	compressedRate_(0),
+	depthCompression_("png"),
 	callbackCalled_(false),
+	lastCompressedStamp_(0.0),
+	latencyTrace_(false),
+	compressionQueueSize_(2),
+	compressionDropped_(0),
+	compressionStop_(false),
 	approxSyncDepth_(0),
 	exactSyncDepth_(0)
 {
 	int queueSize = 10;
 	bool approxSync = true;
+	int compressionThreads = 1;
+	int compressionQueueSize = compressionQueueSize_;
 	approxSync = this->declare_parameter("approx_sync", approxSync);
 	queueSize = this->declare_parameter("queue_size", queueSize);
 	depthScale_ = this->declare_parameter("depth_scale", depthScale_);
 	compressedRate_ = this->declare_parameter("compressed_rate", compressedRate_);
+	depthCompression_ = this->declare_parameter("depth_compression", depthCompression_);
+	compressionThreads = this->declare_parameter("compressed_threads", compressionThreads);
+	compressionQueueSize = this->declare_parameter("compressed_queue_size", compressionQueueSize);
+	latencyTrace_ = this->declare_parameter("latency_trace", latencyTrace_);
 
 	RCLCPP_INFO(this->get_logger(), "%s: approx_sync = %s", get_name(), approxSync?"true":"false");
 	RCLCPP_INFO(this->get_logger(), "%s: queue_size  = %d", get_name(), queueSize);
 	RCLCPP_INFO(this->get_logger(), "%s: depth_scale = %f", get_name(), depthScale_);
 	RCLCPP_INFO(this->get_logger(), "%s: compressed_rate = %f", get_name(), compressedRate_);
+	RCLCPP_INFO(this->get_logger(), "%s: depth_compression = %s", get_name(), depthCompression_.c_str());
+	RCLCPP_INFO(this->get_logger(), "%s: compressed_threads = %d", get_name(), compressionThreads);
+	RCLCPP_INFO(this->get_logger(), "%s: compressed_queue_size = %d", get_name(), compressionQueueSize);
+	RCLCPP_INFO(this->get_logger(), "%s: latency_trace = %s", get_name(), latencyTrace_?"true":"false");
 
 	rgbdImagePub_ = this->create_publisher<rtabmap_ros::msg::RGBDImage>("rgbd_image", 1);
 	rgbdImageCompressedPub_ = this->create_publisher<rtabmap_ros::msg::RGBDImage>("rgbd_image/compressed", 1);
+	if(latencyTrace_)
+	{
+		latencyTracePub_ = this->create_publisher<rtabmap_ros::msg::LatencyTrace>("rgbd_image/latency_trace", 1);
+		compressedLatencyTracePub_ = this->create_publisher<rtabmap_ros::msg::LatencyTrace>("rgbd_image/compressed/latency_trace", 1);
+	}
+
+	compressionQueueSize_ = compressionQueueSize>0?compressionQueueSize:1;
+	lastCompressionDropWarning_ = now();
+	for(int i=0; i<(compressionThreads>0?compressionThreads:1); ++i)
+	{
+		compressionThreads_.push_back(new std::thread(&RGBDSync::compressionLoop, this));
+	}
 
 	if(approxSync)
 	{
@@ -110,6 +139,16 @@ RGBDSync::RGBDSync(const rclcpp::NodeOptions & options) :
 
 RGBDSync::~RGBDSync()
 {
+	compressionMutex_.lock();
+	compressionStop_ = true;
+	compressionMutex_.unlock();
+	compressionCondition_.notify_all();
+	for(size_t i=0; i<compressionThreads_.size(); ++i)
+	{
+		compressionThreads_[i]->join();
+		delete compressionThreads_[i];
+	}
+
 	delete approxSyncDepth_;
 	delete exactSyncDepth_;
 	callbackCalled_ = true;
@@ -125,6 +164,7 @@ void RGBDSync::callback(
 	callbackCalled_ = true;
 	if(rgbdImagePub_->get_subscription_count() || rgbdImageCompressedPub_->get_subscription_count())
 	{
+		rclcpp::Time timeStart = now();
 		double rgbStamp = timestampFromROS(image->header.stamp);
 		double depthStamp = timestampFromROS(depth->header.stamp);
 
@@ -136,44 +176,55 @@ void RGBDSync::callback(
 
 		if(rgbdImageCompressedPub_->get_subscription_count())
 		{
+			// Throttle on data stamps, so that the rate is respected when
+			// playing back data faster or slower than real time.
+			double stamp = timestampFromROS(msg->header.stamp);
 			bool publishCompressed = true;
-			if (compressedRate_ > 0.0)
+			if (compressedRate_ > 0.0 && stamp >= lastCompressedStamp_)
 			{
-				if ( lastCompressedPublished_ + rclcpp::Duration(1.0/compressedRate_) > now())
+				if ( lastCompressedStamp_ + 1.0/compressedRate_ > stamp)
 				{
-					RCLCPP_DEBUG(this->get_logger(), "throttle last update at %f skipping", lastCompressedPublished_.seconds());
+					RCLCPP_DEBUG(this->get_logger(), "throttle last update at %f skipping", lastCompressedStamp_);
 					publishCompressed = false;
 				}
 			}
 
 			if(publishCompressed)
 			{
-				lastCompressedPublished_ = now();
-
-				rtabmap_ros::msg::RGBDImage::UniquePtr msgCompressed(new rtabmap_ros::msg::RGBDImage);
-				*msgCompressed = *msg;
+				lastCompressedStamp_ = stamp;
 
-				cv_bridge::CvImageConstPtr imagePtr = cv_bridge::toCvShare(image);
-				imagePtr->toCompressedImageMsg(msgCompressed->rgb_compressed, cv_bridge::JPG);
+				CompressionJob job;
+				job.msg.reset(new rtabmap_ros::msg::RGBDImage);
+				*job.msg = *msg;
+				job.image = image;
+				job.depth = depth;
+				job.queued = now();
 
-				cv_bridge::CvImageConstPtr imageDepthPtr = cv_bridge::toCvShare(depth);
-				msgCompressed->depth_compressed.header = imageDepthPtr->header;
-				if(depthScale_ != 1.0)
-				{
-					msgCompressed->depth_compressed.data = rtabmap::compressImage(imageDepthPtr->image*depthScale_, ".png");
-				}
-				else
+				compressionMutex_.lock();
+				if(compressionQueue_.size() >= compressionQueueSize_)
 				{
-					msgCompressed->depth_compressed.data = rtabmap::compressImage(imageDepthPtr->image, ".png");
+					// workers are too slow, drop the oldest
+					compressionQueue_.pop_front();
+					++compressionDropped_;
 				}
-				msgCompressed->depth_compressed.format = "png";
-
-				rgbdImageCompressedPub_->publish(std::move(msgCompressed));
+				compressionQueue_.push_back(std::move(job));
+				compressionMutex_.unlock();
+				compressionCondition_.notify_one();
 			}
 		}
 
 		if(rgbdImagePub_->get_subscription_count())
 		{
+			rtabmap_ros::msg::LatencyTrace traceMsg;
+			if(latencyTrace_)
+			{
+				traceMsg.header = msg->header;
+				traceMsg.stages.push_back("sync");
+				traceMsg.start.push_back(timestampFromROS(msg->header.stamp));
+				traceMsg.duration.push_back((timeStart - rclcpp::Time(msg->header.stamp)).seconds());
+			}
+			rclcpp::Time timePublish = now();
+
 			msg->rgb = *image;
 			if(depthScale_ != 1.0)
 			{
@@ -186,6 +237,14 @@ void RGBDSync::callback(
 				msg->depth = *depth;
 			}
 			rgbdImagePub_->publish(std::move(msg));
+
+			if(latencyTrace_ && latencyTracePub_->get_subscription_count())
+			{
+				traceMsg.stages.push_back("publish");
+				traceMsg.start.push_back(timePublish.seconds());
+				traceMsg.duration.push_back((now() - timePublish).seconds());
+				latencyTracePub_->publish(traceMsg);
+			}
 		}
 
 		if( rgbStamp != timestampFromROS(image->header.stamp) ||
@@ -201,6 +260,91 @@ void RGBDSync::callback(
 	}
 }
 
+void RGBDSync::compressionLoop()
+{
+	while(true)
+	{
+		CompressionJob job;
+		int dropped = 0;
+		{
+			std::unique_lock<std::mutex> lock(compressionMutex_);
+			compressionCondition_.wait(lock, [this](){return compressionStop_ || !compressionQueue_.empty();});
+			if(compressionStop_)
+			{
+				return;
+			}
+			job = std::move(compressionQueue_.front());
+			compressionQueue_.pop_front();
+			// warn at most every 5 seconds
+			if(compressionDropped_ && (job.queued - lastCompressionDropWarning_).seconds() > 5.0)
+			{
+				dropped = compressionDropped_;
+				compressionDropped_ = 0;
+				lastCompressionDropWarning_ = job.queued;
+			}
+		}
+		if(dropped)
+		{
+			RCLCPP_WARN(this->get_logger(), "%s: %d frame(s) dropped from compressed output as compression "
+					"is slower than input rate (compressed_queue_size=%d). Consider increasing "
+					"\"compressed_threads\" or setting \"compressed_rate\".",
+					get_name(), dropped, (int)compressionQueueSize_);
+		}
+		compress(job);
+	}
+}
+
+void RGBDSync::compress(CompressionJob & job)
+{
+	if(!rgbdImageCompressedPub_->get_subscription_count())
+	{
+		return;
+	}
+
+	rclcpp::Time timeStart = now();
+
+	cv_bridge::CvImageConstPtr imagePtr = cv_bridge::toCvShare(job.image);
+	imagePtr->toCompressedImageMsg(job.msg->rgb_compressed, cv_bridge::JPG);
+	rclcpp::Time timeRgb = now();
+
+	cv_bridge::CvImageConstPtr imageDepthPtr = cv_bridge::toCvShare(job.depth);
+	job.msg->depth_compressed.header = imageDepthPtr->header;
+	if(depthScale_ != 1.0)
+	{
+		cv::Mat scaledDepth = imageDepthPtr->image*depthScale_;
+		job.msg->depth_compressed.data = compressDepth(scaledDepth, depthCompression_, job.msg->depth_compressed.format);
+	}
+	else
+	{
+		job.msg->depth_compressed.data = compressDepth(imageDepthPtr->image, depthCompression_, job.msg->depth_compressed.format);
+	}
+	rclcpp::Time timeDepth = now();
+
+	rtabmap_ros::msg::LatencyTrace traceMsg;
+	if(latencyTrace_)
+	{
+		traceMsg.header = job.msg->header;
+	}
+	rgbdImageCompressedPub_->publish(std::move(job.msg));
+
+	if(latencyTrace_ && compressedLatencyTracePub_->get_subscription_count())
+	{
+		traceMsg.stages.push_back("queue");
+		traceMsg.start.push_back(job.queued.seconds());
+		traceMsg.duration.push_back((timeStart - job.queued).seconds());
+		traceMsg.stages.push_back("rgb_compress");
+		traceMsg.start.push_back(timeStart.seconds());
+		traceMsg.duration.push_back((timeRgb - timeStart).seconds());
+		traceMsg.stages.push_back("depth_compress");
+		traceMsg.start.push_back(timeRgb.seconds());
+		traceMsg.duration.push_back((timeDepth - timeRgb).seconds());
+		traceMsg.stages.push_back("publish");
+		traceMsg.start.push_back(timeDepth.seconds());
+		traceMsg.duration.push_back((now() - timeDepth).seconds());
+		compressedLatencyTracePub_->publish(traceMsg);
+	}
+}
+
 }
 
 #include "rclcpp_components/register_node_macro.hpp"
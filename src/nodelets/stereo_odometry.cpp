@@ -155,7 +155,7 @@ void StereoOdometry::callback(
 
 		rclcpp::Time stamp = timestampFromROS(imageRectLeft->header.stamp)>timestampFromROS(imageRectRight->header.stamp)?imageRectLeft->header.stamp:imageRectRight->header.stamp;
 
-		Transform localTransform = getTransform(this->frameId(), imageRectLeft->header.frame_id, stamp, tfBuffer(), waitForTransform());
+		Transform localTransform = lookupTransform(this->frameId(), imageRectLeft->header.frame_id, stamp);
 		if(localTransform.isNull())
 		{
 			return;
@@ -168,12 +168,10 @@ void StereoOdometry::callback(
 			rtabmap::Transform stereoTransform;
 			if(!alreadyRectified)
 			{
-				stereoTransform = getTransform(
+				stereoTransform = lookupTransform(
 						cameraInfoRight->header.frame_id,
 						cameraInfoLeft->header.frame_id,
-						cameraInfoLeft->header.stamp,
-						tfBuffer(),
-						waitForTransform());
+						cameraInfoLeft->header.stamp);
 				if(stereoTransform.isNull())
 				{
 					RCLCPP_ERROR(this->get_logger(), "Parameter %s is false but we cannot get TF between the two cameras!", Parameters::kRtabmapImagesAlreadyRectified().c_str());
@@ -254,7 +252,7 @@ void StereoOdometry::callbackRGBD(
 
 		rclcpp::Time stamp = timestampFromROS(imageRectLeft->header.stamp)>timestampFromROS(imageRectRight->header.stamp)?imageRectLeft->header.stamp:imageRectRight->header.stamp;
 
-		Transform localTransform = getTransform(this->frameId(), imageRectLeft->header.frame_id, stamp, tfBuffer(), waitForTransform());
+		Transform localTransform = lookupTransform(this->frameId(), imageRectLeft->header.frame_id, stamp);
 		if(localTransform.isNull())
 		{
 			return;
@@ -56,6 +56,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <rtabmap/core/Graph.h>
 #include <rtabmap_ros/MsgConversion.h>
 #include <rtabmap_ros/srv/get_map.hpp>
+#include <rtabmap_ros/srv/get_map_page.hpp>
 
 
 namespace rtabmap_ros
@@ -253,13 +254,13 @@ void MapCloudDisplay::processMessage( const rtabmap_ros::msg::MapData::ConstShar
 	this->emitTimeSignal(msg->header.stamp);
 }
 
-void MapCloudDisplay::processMapData(const rtabmap_ros::msg::MapData& map)
+void MapCloudDisplay::processMapData(const rtabmap_ros::msg::MapData& map, bool updateGraph)
 {
+	// The graph may be delta encoded (see map_delta_keyframe_interval of rtabmap node)
 	std::map<int, rtabmap::Transform> poses;
-	for(unsigned int i=0; i<map.graph.poses_id.size() && i<map.graph.poses.size(); ++i)
-	{
-		poses.insert(std::make_pair(map.graph.poses_id[i], rtabmap_ros::transformFromPoseMsg(map.graph.poses[i])));
-	}
+	std::multimap<int, rtabmap::Link> links;
+	rtabmap::Transform mapToOdom;
+	bool graphValid = graph_decoder_.decode(map.graph, poses, links, mapToOdom);
 
 	// Add new clouds...
 	bool fromDepth = !cloud_from_scan_->getBool();
@@ -362,15 +363,16 @@ void MapCloudDisplay::processMapData(const rtabmap_ros::msg::MapData& map)
 		}
 	}
 
-	// Update graph
-	if(node_filtering_angle_->getFloat() > 0.0f && node_filtering_radius_->getFloat() > 0.0f)
+	// Update graph, keep the previous one until the delta stream is valid again
+	if(updateGraph && graphValid)
 	{
-		poses = rtabmap::graph::radiusPosesFiltering(poses,
-				node_filtering_radius_->getFloat(),
-				node_filtering_angle_->getFloat()*CV_PI/180.0);
-	}
+		if(node_filtering_angle_->getFloat() > 0.0f && node_filtering_radius_->getFloat() > 0.0f)
+		{
+			poses = rtabmap::graph::radiusPosesFiltering(poses,
+					node_filtering_radius_->getFloat(),
+					node_filtering_angle_->getFloat()*CV_PI/180.0);
+		}
 
-	{
 		std::unique_lock<std::mutex> lock(current_map_mutex_);
 		current_map_ = poses;
 	}
@@ -488,8 +490,8 @@ void MapCloudDisplay::downloadMap()
 	{
 		QMessageBox * messageBox = new QMessageBox(
 				QMessageBox::NoIcon,
-				tr("Calling \"%1\" service...").arg("get_map_data"),
-				tr("Downloading the map... please wait (rviz could become gray!)"),
+				tr("Calling \"%1\" service...").arg("get_map_data_page"),
+				tr("Downloading the map... please wait"),
 				QMessageBox::NoButton);
 		messageBox->setAttribute(Qt::WA_DeleteOnClose, true);
 		messageBox->show();
@@ -498,41 +500,95 @@ void MapCloudDisplay::downloadMap()
 		QApplication::processEvents();
 
 		auto node = rclcpp::Node::make_shared(rviz_ros_node_.lock()->get_node_name());
-		 auto client = node->create_client<rtabmap_ros::srv::GetMap>("get_map_data");
+		 auto client = node->create_client<rtabmap_ros::srv::GetMapPage>("get_map_data_page");
+		 auto mapClient = node->create_client<rtabmap_ros::srv::GetMap>("get_map_data");
+		int poses = 0;
+		int clouds = 0;
+		std::string errorMsg;
 		if(client->wait_for_service(std::chrono::seconds(2)))
 		{
+			// Download the map by pages, so that clouds are shown progressively
+			// and rtabmap node is not blocked for a long time
+			auto request = std::make_shared<rtabmap_ros::srv::GetMapPage::Request>();
+			request->global = true;
+			request->optimized = true;
+			bool firstPage = true;
+			do
+			{
+				auto result_future = client->async_send_request(request);
+				if (rclcpp::spin_until_future_complete(node, result_future) != rclcpp::executor::FutureReturnCode::SUCCESS)
+				{
+					errorMsg = uFormat("MapCloudDisplay: Service \"get_map_data_page\" failed to get the data (%d clouds downloaded).", clouds);
+					RVIZ_COMMON_LOG_ERROR(errorMsg);
+					break;
+				}
+				auto result = result_future.get();
+				if(!result->success)
+				{
+					errorMsg = uFormat("MapCloudDisplay: Service \"get_map_data_page\" failed: %s", result->error.c_str());
+					RVIZ_COMMON_LOG_ERROR(errorMsg);
+					break;
+				}
+				if(firstPage)
+				{
+					this->reset();
+					poses = result->data.graph.poses.size();
+				}
+				processMapData(result->data, firstPage);
+				firstPage = false;
+				clouds += result->data.nodes.size();
+				request->continuation_token = result->next_token;
+
+				messageBox->setText(tr("Creating all clouds (%1 poses and %2/%3 clouds downloaded)...")
+						.arg(poses).arg(clouds).arg(result->total_nodes));
+				QApplication::processEvents();
+			}
+			while(!request->continuation_token.empty());
+		}
+		else if(mapClient->wait_for_service(std::chrono::seconds(1)))
+		{
+			// rtabmap node without get_map_data_page service, download all at once
+			RCLCPP_WARN(node->get_logger(), "Service \"get_map_data_page\" is not available, using \"get_map_data\" (rviz could become gray!)");
 			auto request = std::make_shared<rtabmap_ros::srv::GetMap::Request>();
 			request->global = true;
 			request->optimized = true;
 			request->graph_only = false;
-			auto result_future = client->async_send_request(request);
+			auto result_future = mapClient->async_send_request(request);
 			if (rclcpp::spin_until_future_complete(node, result_future) != rclcpp::executor::FutureReturnCode::SUCCESS)
 			{
-				RCLCPP_ERROR(node->get_logger(), "Service \"get_map_data\" failed to get the data.");
+				errorMsg = "MapCloudDisplay: Service \"get_map_data\" failed to get the data.";
+				RVIZ_COMMON_LOG_ERROR(errorMsg);
 			}
 			else
 			{
 				auto result = result_future.get();
-
+				poses = result->data.graph.poses.size();
+				clouds = result->data.nodes.size();
 				messageBox->setText(tr("Creating all clouds (%1 poses and %2 clouds downloaded)...")
-						.arg(result->data.graph.poses.size()).arg(result->data.nodes.size()));
+						.arg(poses).arg(clouds));
 				QApplication::processEvents();
 				this->reset();
 				processMapData(result->data);
-				messageBox->setText(tr("Creating all clouds (%1 poses and %2 clouds downloaded)... done!")
-						.arg(result->data.graph.poses.size()).arg(result->data.nodes.size()));
-
-				QTimer::singleShot(1000, messageBox, SLOT(close()));
 			}
 		}
 		else
 		{
-			std::string msg = uFormat("MapCloudDisplay: Can't call \"get_map_data\" service. "
-					  "Tip: if rtabmap node is not in rtabmap namespace, you can remap the service "
-					  "to \"get_map_data\" in the launch "
-					  "file like: <remap from=\"get_map_data\" to=\"/rtabmap/get_map_data\"/>.");
-			RVIZ_COMMON_LOG_ERROR(msg);
-			messageBox->setText(msg.c_str());
+			errorMsg = uFormat("MapCloudDisplay: Can't call \"get_map_data_page\" or \"get_map_data\" services. "
+					  "Tip: if rtabmap node is not in rtabmap namespace, you can remap the services "
+					  "in the launch file like: <remap from=\"get_map_data_page\" to=\"/rtabmap/get_map_data_page\"/> "
+					  "and <remap from=\"get_map_data\" to=\"/rtabmap/get_map_data\"/>.");
+			RVIZ_COMMON_LOG_ERROR(errorMsg);
+		}
+
+		if(errorMsg.empty())
+		{
+			messageBox->setText(tr("Creating all clouds (%1 poses and %2 clouds downloaded)... done!")
+					.arg(poses).arg(clouds));
+			QTimer::singleShot(1000, messageBox, SLOT(close()));
+		}
+		else
+		{
+			messageBox->setText(errorMsg.c_str());
 		}
 
 		download_map_->blockSignals(true);
@@ -763,6 +819,7 @@ void MapCloudDisplay::reset()
 		std::unique_lock<std::mutex> lock(current_map_mutex_);
 		current_map_.clear();
 	}
+	graph_decoder_.reset();
 }
 
 void MapCloudDisplay::updateXyzTransformer()
@@ -38,6 +38,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <rtabmap_ros/visibility.h>
 #include <rtabmap_ros/msg/map_data.hpp>
+#include <rtabmap_ros/MsgConversion.h>
 #include <rtabmap/core/Transform.h>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
@@ -149,7 +150,9 @@ protected:
 	virtual void processMessage( const rtabmap_ros::msg::MapData::ConstSharedPtr cloud );
 	void onInitialize();
 private:
-	void processMapData(const rtabmap_ros::msg::MapData& map);
+	// If updateGraph is false, only clouds of the nodes are added (e.g., pages
+	// following the first one of get_map_data_page service)
+	void processMapData(const rtabmap_ros::msg::MapData& map, bool updateGraph = true);
 
 	/**
 	* \brief Transforms the cloud into the correct frame, and sets up our renderable cloud
@@ -178,6 +181,7 @@ private:
 
 	std::map<int, rtabmap::Transform> current_map_;
 	std::mutex current_map_mutex_;
+	MapGraphDeltaDecoder graph_decoder_;
 
 	struct TransformerInfo
 	{
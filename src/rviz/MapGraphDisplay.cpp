@@ -73,6 +73,7 @@ void MapGraphDisplay::reset()
 {
   MFDClass::reset();
   destroyObjects();
+  decoder_.reset();
 }
 
 void MapGraphDisplay::destroyObjects()
@@ -97,7 +98,11 @@ void MapGraphDisplay::processMessage( const rtabmap_ros::msg::MapGraph::ConstSha
 	std::map<int, rtabmap::Transform> poses;
 	std::multimap<int, rtabmap::Link> links;
 	rtabmap::Transform mapToOdom;
-	rtabmap_ros::mapGraphFromROS(*msg, poses, links, mapToOdom);
+	if(!decoder_.decode(*msg, poses, links, mapToOdom))
+	{
+		// missed a delta message, wait for the next full graph
+		return;
+	}
 
 	destroyObjects();
 
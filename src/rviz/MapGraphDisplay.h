@@ -31,6 +31,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <rtabmap_ros/visibility.h>
 #include <rtabmap_ros/msg/map_graph.hpp>
+#include <rtabmap_ros/MsgConversion.h>
 
 #include <rviz_common/message_filter_display.hpp>
 
@@ -80,6 +81,7 @@ private:
   void destroyObjects();
 
   std::vector<Ogre::ManualObject*> manual_objects_;
+  MapGraphDeltaDecoder decoder_;
 
   rviz_common::properties::ColorProperty* color_neighbor_property_;
   rviz_common::properties::ColorProperty* color_neighbor_merged_property_;